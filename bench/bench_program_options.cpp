@@ -0,0 +1,823 @@
+/*
+ *  bench_program_options.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This program measures the performance of the Program Options library.
+ *      It exercises ParseArguments() across a range of option specification
+ *      sizes and argument counts, short option bundles, long options with
+ *      values, single- and two-pass parse strategies, case-insensitive
+ *      matching, the GetOption*() query functions, numeric conversions,
+ *      request-scoped parsing using a ParserPool, and the cost of
+ *      SetOptions() validation.
+ *
+ *      Results are written as JSON so they may be recorded and compared to
+ *      detect performance regressions.  Each benchmark reports the number
+ *      of iterations performed, the total time, the time per iteration, and
+ *      the number of items (e.g., arguments) processed per second.
+ *
+ *      Adversarial cases measure inputs crafted to defeat the matching logic,
+ *      such as long arguments sharing long prefixes with many option names,
+ *      very long short option bundles, and very long invalid arguments that
+ *      produce exceptions.  The time per item in these cases should remain
+ *      constant as the input grows.
+ *
+ *      To bound the time spent generating inputs, cases where the product of
+ *      the number of options and the number of arguments exceeds the
+ *      "max-work" value are reported as skipped.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+#include <mutex>
+#include <terra/program_options/program_options.h>
+#include <terra/program_options/parser_pool.h>
+
+namespace
+{
+
+// Prevent the compiler from optimizing away benchmarked work
+volatile std::size_t benchmark_sink = 0;
+
+// Define a structure to hold the results of a single benchmark
+struct BenchmarkResult
+{
+    std::string name;
+    bool skipped;
+    std::size_t iterations;
+    double total_ns;
+    std::size_t items_per_iteration;
+};
+
+// Define the object used to run benchmarks and collect results
+class BenchmarkRunner
+{
+    public:
+        BenchmarkRunner(std::string filter, double min_time, double max_work) :
+            filter{std::move(filter)},
+            min_time{min_time},
+            max_work{max_work}
+        {
+        }
+
+        // Returns true if the named benchmark should be run
+        bool Selected(const std::string &name) const
+        {
+            return filter.empty() || (name.find(filter) != std::string::npos);
+        }
+
+        // Returns true if the given amount of work is within the limit
+        bool WithinLimit(double work) const
+        {
+            return (max_work <= 0.0) || (work <= max_work);
+        }
+
+        // Record a benchmark that was not run
+        void Skip(const std::string &name)
+        {
+            if (!Selected(name)) return;
+
+            results.push_back({name, true, 0, 0.0, 0});
+        }
+
+        // Run the given function repeatedly for at least min_time seconds
+        void Run(const std::string &name,
+                 std::size_t items_per_iteration,
+                 const std::function<void()> &function)
+        {
+            if (!Selected(name)) return;
+
+            std::size_t iterations = 0;
+            auto start = std::chrono::steady_clock::now();
+            std::chrono::duration<double> elapsed{};
+
+            do
+            {
+                function();
+                iterations++;
+                elapsed = std::chrono::steady_clock::now() - start;
+            } while (elapsed.count() < min_time);
+
+            results.push_back({name,
+                               false,
+                               iterations,
+                               elapsed.count() * 1e9,
+                               items_per_iteration});
+
+            std::cerr << name << ": "
+                      << (elapsed.count() * 1e9 /
+                          static_cast<double>(iterations))
+                      << " ns/iteration" << std::endl;
+        }
+
+        // Write the results as JSON
+        void WriteJSON(std::ostream &out) const
+        {
+            out << "{" << std::endl
+                << "  \"context\": {" << std::endl
+                << "    \"library\": \"program_options\"," << std::endl
+                << "    \"min_time_seconds\": " << min_time << "," << std::endl
+                << "    \"max_work\": " << max_work << std::endl
+                << "  }," << std::endl
+                << "  \"benchmarks\": [";
+
+            for (std::size_t i = 0; i < results.size(); i++)
+            {
+                const auto &result = results[i];
+
+                out << ((i == 0) ? "" : ",") << std::endl
+                    << "    {" << std::endl
+                    << "      \"name\": \"" << result.name << "\"," << std::endl
+                    << "      \"skipped\": "
+                    << (result.skipped ? "true" : "false");
+
+                if (!result.skipped)
+                {
+                    const double per_iteration =
+                        result.total_ns / static_cast<double>(result.iterations);
+                    const double items_per_second =
+                        static_cast<double>(result.items_per_iteration) * 1e9 /
+                        per_iteration;
+
+                    out << "," << std::endl
+                        << "      \"iterations\": " << result.iterations << ","
+                        << std::endl
+                        << "      \"total_ns\": " << std::fixed
+                        << std::setprecision(0) << result.total_ns << ","
+                        << std::endl
+                        << "      \"ns_per_iteration\": " << std::setprecision(1)
+                        << per_iteration << "," << std::endl
+                        << "      \"items_per_iteration\": "
+                        << result.items_per_iteration << "," << std::endl
+                        << "      \"items_per_second\": " << std::setprecision(1)
+                        << items_per_second
+                        << std::defaultfloat << std::setprecision(6);
+                }
+
+                out << std::endl << "    }";
+            }
+
+            out << std::endl << "  ]" << std::endl << "}" << std::endl;
+        }
+
+    protected:
+        std::string filter;
+        double min_time;
+        double max_work;
+        std::vector<BenchmarkResult> results;
+};
+
+// Define a set of arguments along with an argv-style array referring to them
+struct Arguments
+{
+    Arguments() : strings{"program"}
+    {
+    }
+
+    void Add(std::string argument)
+    {
+        strings.emplace_back(std::move(argument));
+    }
+
+    // Build the argv array (must be called after all strings are added)
+    void Finalize()
+    {
+        argv.clear();
+        for (const auto &string : strings) argv.push_back(string.c_str());
+    }
+
+    int argc() const
+    {
+        return static_cast<int>(argv.size());
+    }
+
+    std::vector<std::string> strings;
+    std::vector<const char *> argv;
+};
+
+// Produce a specification having the given number of options
+Terra::ProgramOptions::Options MakeOptions(std::size_t count)
+{
+    const std::string letters = "abcdefghijklmnopqrstuvwxyz"
+                                "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    Terra::ProgramOptions::Options options;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        options.push_back({"opt" + std::to_string(i),
+                           (i < letters.size()) ? letters.substr(i, 1) : "",
+                           "option-" + std::to_string(i),
+                           true,
+                           (i % 2) == 0});
+    }
+
+    return options;
+}
+
+// Produce long-option arguments using the given options
+Arguments MakeLongArguments(const Terra::ProgramOptions::Options &options,
+                            std::size_t count,
+                            bool mixed_case = false)
+{
+    Arguments arguments;
+    std::size_t k = 0;
+
+    while ((arguments.strings.size() - 1) < count)
+    {
+        // Spread the selected options across the specification
+        const auto &option = options[(k * 7919) % options.size()];
+        std::string name = option.long_option;
+
+        if (mixed_case)
+        {
+            for (std::size_t i = 0; i < name.size(); i += 2)
+            {
+                if ((name[i] >= 'a') && (name[i] <= 'z')) name[i] -= 32;
+            }
+        }
+
+        if (!option.parameter_expected)
+        {
+            arguments.Add("--" + name);
+        }
+        else if ((k % 2) == 0)
+        {
+            arguments.Add("--" + name + "=value" + std::to_string(k));
+        }
+        else if ((arguments.strings.size() + 1) < count)
+        {
+            arguments.Add("--" + name);
+            arguments.Add("value" + std::to_string(k));
+        }
+        else
+        {
+            arguments.Add("file" + std::to_string(k));
+        }
+
+        k++;
+    }
+
+    arguments.Finalize();
+
+    return arguments;
+}
+
+// Benchmark ParseArguments() across specification sizes and argument counts
+void BenchmarkParseScaling(BenchmarkRunner &runner)
+{
+    for (std::size_t option_count : {10, 100, 1'000, 10'000})
+    {
+        const auto options = MakeOptions(option_count);
+
+        for (std::size_t argument_count : {10, 1'000, 100'000, 1'000'000})
+        {
+            const std::string name = "parse_long/options:" +
+                                     std::to_string(option_count) +
+                                     "/arguments:" +
+                                     std::to_string(argument_count);
+
+            if (!runner.Selected(name)) continue;
+
+            if (!runner.WithinLimit(static_cast<double>(option_count) *
+                                    static_cast<double>(argument_count)))
+            {
+                runner.Skip(name);
+                continue;
+            }
+
+            const Arguments arguments =
+                                MakeLongArguments(options, argument_count);
+            Terra::ProgramOptions::Parser parser(options);
+
+            runner.Run(name,
+                       argument_count,
+                       [&]()
+                       {
+                           parser.ClearOptions();
+                           parser.ParseArguments(arguments.argc(),
+                                                 arguments.argv.data());
+                       });
+        }
+    }
+}
+
+// Benchmark parsing long options given with "=" values
+void BenchmarkLongEquals(BenchmarkRunner &runner)
+{
+    const auto options = MakeOptions(20);
+    Arguments arguments;
+
+    for (std::size_t i = 0; i < 10'000; i++)
+    {
+        arguments.Add("--option-" + std::to_string((i * 2) % 20) +
+                      "=some-value-" + std::to_string(i));
+    }
+    arguments.Finalize();
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    runner.Run("parse_long_equals/arguments:10000",
+               10'000,
+               [&]()
+               {
+                   parser.ClearOptions();
+                   parser.ParseArguments(arguments.argc(),
+                                         arguments.argv.data());
+               });
+}
+
+// Benchmark parse strategies when a fresh parser stores many values
+void BenchmarkParseStrategies(BenchmarkRunner &runner)
+{
+    const auto options = MakeOptions(20);
+    Arguments arguments;
+
+    for (std::size_t i = 0; i < 100'000; i++)
+    {
+        arguments.Add("--option-0=value-" + std::to_string(i));
+        arguments.Add("file-" + std::to_string(i));
+    }
+    arguments.Finalize();
+
+    for (auto [strategy, strategy_name] :
+            {std::pair{Terra::ProgramOptions::ParseStrategy::SinglePass,
+                       "single_pass"},
+             std::pair{Terra::ProgramOptions::ParseStrategy::TwoPass,
+                       "two_pass"}})
+    {
+        runner.Run(std::string("parse_strategy/strategy:") + strategy_name +
+                       "/arguments:200000",
+                   200'000,
+                   [&]()
+                   {
+                       Terra::ProgramOptions::Parser parser(options);
+                       parser.SetParseStrategy(strategy);
+                       parser.ParseArguments(arguments.argc(),
+                                             arguments.argv.data());
+                   });
+    }
+}
+
+// Benchmark parsing bundled short options (e.g., "-abcdefgh")
+void BenchmarkShortBundles(BenchmarkRunner &runner)
+{
+    Terra::ProgramOptions::Options options;
+    const std::string letters = "abcdefghijklmnopqrstuvwxyz";
+
+    for (const auto c : letters)
+    {
+        options.push_back({std::string(1, c), std::string(1, c), "", true,
+                           false});
+    }
+
+    for (std::size_t bundle_length : {2, 8, 26})
+    {
+        Arguments arguments;
+        const std::string bundle =
+                        std::string("-").append(letters, 0, bundle_length);
+
+        for (std::size_t i = 0; i < 10'000; i++) arguments.Add(bundle);
+        arguments.Finalize();
+
+        Terra::ProgramOptions::Parser parser(options);
+
+        runner.Run("parse_short_bundle/length:" +
+                       std::to_string(bundle_length) + "/arguments:10000",
+                   10'000 * bundle_length,
+                   [&]()
+                   {
+                       parser.ClearOptions();
+                       parser.ParseArguments(arguments.argc(),
+                                             arguments.argv.data());
+                   });
+    }
+}
+
+// Benchmark case-insensitive matching
+void BenchmarkCaseInsensitive(BenchmarkRunner &runner)
+{
+    for (std::size_t option_count : {10, 100})
+    {
+        const auto options = MakeOptions(option_count);
+        const Arguments arguments = MakeLongArguments(options, 10'000, true);
+        Terra::ProgramOptions::Parser parser(options,
+                                             {"-"},
+                                             {"--"},
+                                             "=",
+                                             true);
+
+        runner.Run("parse_case_insensitive/options:" +
+                       std::to_string(option_count) + "/arguments:10000",
+                   10'000,
+                   [&]()
+                   {
+                       parser.ClearOptions();
+                       parser.ParseArguments(arguments.argc(),
+                                             arguments.argv.data());
+                   });
+    }
+}
+
+// Benchmark the GetOption*() query functions
+void BenchmarkQueries(BenchmarkRunner &runner)
+{
+    const auto options = MakeOptions(1'000);
+    const Arguments arguments = MakeLongArguments(options, 10'000);
+    Terra::ProgramOptions::Parser parser(options);
+    std::vector<std::string> names;
+
+    parser.ParseArguments(arguments.argc(), arguments.argv.data());
+    for (const auto &option : options) names.push_back(option.name);
+
+    runner.Run("query_option_given/options:1000",
+               names.size(),
+               [&]()
+               {
+                   std::size_t given = 0;
+                   for (const auto &name : names)
+                   {
+                       given += parser.OptionGiven(name) ? 1 : 0;
+                   }
+                   benchmark_sink = benchmark_sink + given;
+               });
+
+    runner.Run("query_option_count/options:1000",
+               names.size(),
+               [&]()
+               {
+                   std::size_t count = 0;
+                   for (const auto &name : names)
+                   {
+                       count += parser.GetOptionCount(name);
+                   }
+                   benchmark_sink = benchmark_sink + count;
+               });
+
+    // Only options taking values have strings to retrieve
+    std::vector<std::string> value_names;
+    for (const auto &option : options)
+    {
+        if (option.parameter_expected && parser.OptionGiven(option.name))
+        {
+            value_names.push_back(option.name);
+        }
+    }
+
+    runner.Run("query_option_string/options:" +
+                   std::to_string(value_names.size()),
+               value_names.size(),
+               [&]()
+               {
+                   std::size_t length = 0;
+                   for (const auto &name : value_names)
+                   {
+                       length += parser.GetOptionString(name).size();
+                   }
+                   benchmark_sink = benchmark_sink + length;
+               });
+
+    runner.Run("query_option_strings/options:" +
+                   std::to_string(value_names.size()),
+               value_names.size(),
+               [&]()
+               {
+                   std::size_t count = 0;
+                   for (const auto &name : value_names)
+                   {
+                       count += parser.GetOptionStrings(name).size();
+                   }
+                   benchmark_sink = benchmark_sink + count;
+               });
+}
+
+// Benchmark numeric conversions performed by GetOptionValues()
+void BenchmarkNumericConversions(BenchmarkRunner &runner)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        { "integer", "i", "integer", true, true },
+        { "real",    "r", "real",    true, true }
+    };
+    Arguments arguments;
+
+    for (std::size_t i = 0; i < 10'000; i++)
+    {
+        arguments.Add("-i");
+        arguments.Add(std::to_string(i * 37));
+        arguments.Add("-r");
+        arguments.Add(std::to_string(static_cast<double>(i) * 0.37));
+    }
+    arguments.Finalize();
+
+    Terra::ProgramOptions::Parser parser(options);
+    parser.ParseArguments(arguments.argc(), arguments.argv.data());
+
+    runner.Run("convert_values/type:int/values:10000",
+               10'000,
+               [&]()
+               {
+                   std::vector<int> values;
+                   parser.GetOptionValues("integer", values);
+                   benchmark_sink = benchmark_sink + values.size();
+               });
+
+    runner.Run("convert_values/type:unsigned_long/values:10000",
+               10'000,
+               [&]()
+               {
+                   std::vector<unsigned long> values;
+                   parser.GetOptionValues("integer", values);
+                   benchmark_sink = benchmark_sink + values.size();
+               });
+
+    runner.Run("convert_values/type:double/values:10000",
+               10'000,
+               [&]()
+               {
+                   std::vector<double> values;
+                   parser.GetOptionValues("real", values, -1e9, 1e9);
+                   benchmark_sink = benchmark_sink + values.size();
+               });
+}
+
+// Benchmark inputs crafted to defeat the matching logic
+void BenchmarkAdversarial(BenchmarkRunner &runner)
+{
+    const std::string prefix(1'000, 'x');
+
+    // Long arguments sharing a long prefix with many option names
+    for (std::size_t option_count : {10, 100, 1'000, 10'000})
+    {
+        Terra::ProgramOptions::Options options;
+        for (std::size_t i = 0; i < option_count; i++)
+        {
+            options.push_back({"opt" + std::to_string(i),
+                               "",
+                               prefix + std::to_string(i),
+                               true,
+                               true});
+        }
+
+        Arguments arguments;
+        for (std::size_t i = 0; i < 1'000; i++)
+        {
+            arguments.Add("--" + prefix + std::to_string(i % option_count) +
+                          "=value");
+        }
+        arguments.Finalize();
+
+        Terra::ProgramOptions::Parser parser(options);
+
+        runner.Run("adversarial_shared_prefix/options:" +
+                       std::to_string(option_count),
+                   1'000,
+                   [&]()
+                   {
+                       parser.ClearOptions();
+                       parser.ParseArguments(arguments.argc(),
+                                             arguments.argv.data());
+                   });
+
+        // An argument sharing the prefix, but matching no option
+        Arguments invalid;
+        invalid.Add("--" + prefix + "z");
+        invalid.Finalize();
+
+        runner.Run("adversarial_rejected_prefix/options:" +
+                       std::to_string(option_count),
+                   1,
+                   [&]()
+                   {
+                       try
+                       {
+                           parser.ClearOptions();
+                           parser.ParseArguments(invalid.argc(),
+                                                 invalid.argv.data());
+                       }
+                       catch (const Terra::ProgramOptions::OptionsException &)
+                       {
+                           benchmark_sink = benchmark_sink + 1;
+                       }
+                   });
+    }
+
+    // Very long invalid arguments, which produce exceptions
+    const Terra::ProgramOptions::Options options = MakeOptions(26);
+    for (std::size_t length : {1'000, 100'000, 10'000'000})
+    {
+        Arguments arguments;
+        arguments.Add("--" + std::string(length, 'q'));
+        arguments.Finalize();
+
+        Terra::ProgramOptions::Parser parser(options);
+
+        runner.Run("adversarial_invalid_argument/length:" +
+                       std::to_string(length),
+                   length,
+                   [&]()
+                   {
+                       try
+                       {
+                           parser.ClearOptions();
+                           parser.ParseArguments(arguments.argc(),
+                                                 arguments.argv.data());
+                       }
+                       catch (const Terra::ProgramOptions::OptionsException &)
+                       {
+                           benchmark_sink = benchmark_sink + 1;
+                       }
+                   });
+    }
+
+    // Very long short option bundles
+    const Terra::ProgramOptions::Options verbose_options =
+    {
+        { "verbose", "v", "verbose", true, false }
+    };
+    for (std::size_t length : {1'000, 100'000, 1'000'000})
+    {
+        Arguments arguments;
+        arguments.Add("-" + std::string(length, 'v'));
+        arguments.Finalize();
+
+        Terra::ProgramOptions::Parser parser(verbose_options);
+
+        runner.Run("adversarial_short_bundle/length:" +
+                       std::to_string(length),
+                   length,
+                   [&]()
+                   {
+                       parser.ClearOptions();
+                       parser.ParseArguments(arguments.argc(),
+                                             arguments.argv.data());
+                   });
+    }
+}
+
+// Benchmark request-scoped parsing using a pool versus other approaches
+void BenchmarkParserPool(BenchmarkRunner &runner)
+{
+    for (std::size_t option_count : {10, 100, 1'000})
+    {
+        const auto options = MakeOptions(option_count);
+        const Arguments arguments = MakeLongArguments(options, 10);
+        const std::string suffix = "/options:" + std::to_string(option_count);
+
+        // Construct a parser for each request
+        runner.Run("request_parse/method:construct" + suffix,
+                   1,
+                   [&]()
+                   {
+                       Terra::ProgramOptions::Parser parser(options);
+                       parser.ParseArguments(arguments.argc(),
+                                             arguments.argv.data());
+                   });
+
+        // Share a single parser, serializing access with a mutex
+        Terra::ProgramOptions::Parser shared_parser(options);
+        std::mutex mutex;
+        runner.Run("request_parse/method:mutex" + suffix,
+                   1,
+                   [&]()
+                   {
+                       std::lock_guard<std::mutex> lock(mutex);
+                       shared_parser.ClearOptions();
+                       shared_parser.ParseArguments(arguments.argc(),
+                                                    arguments.argv.data());
+                   });
+
+        // Acquire a parser from a pool
+        Terra::ProgramOptions::ParserPool<> pool{
+                                    Terra::ProgramOptions::Parser(options)};
+        runner.Run("request_parse/method:pool" + suffix,
+                   1,
+                   [&]()
+                   {
+                       auto handle = pool.Acquire();
+                       handle->ParseArguments(arguments.argc(),
+                                              arguments.argv.data());
+                   });
+    }
+}
+
+// Benchmark the cost of SetOptions() validation
+void BenchmarkSetOptions(BenchmarkRunner &runner)
+{
+    for (std::size_t option_count : {10, 100, 1'000, 10'000})
+    {
+        const auto options = MakeOptions(option_count);
+        Terra::ProgramOptions::Parser parser;
+
+        runner.Run("set_options/options:" + std::to_string(option_count),
+                   option_count,
+                   [&]()
+                   {
+                       parser.SetOptions(options);
+                   });
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name        Short  Long         Multi   Argument
+        { "filter",     "f", "filter",    false,  true  },
+        { "min-time",   "t", "min-time",  false,  true  },
+        { "max-work",   "w", "max-work",  false,  true  },
+        { "output",     "o", "output",    false,  true  },
+        { "help",       "h", "help",      false,  false }
+    };
+    // clang-format on
+
+    std::string filter;
+    double min_time = 0.2;
+    double max_work = 1e9;
+    std::string output;
+
+    try
+    {
+        Terra::ProgramOptions::Parser parser(options);
+        parser.ParseArguments(argc, argv);
+
+        if (parser.OptionGiven("help"))
+        {
+            std::cout << "usage: program_options_bench [--filter <substring>] "
+                      << "[--min-time <seconds>]" << std::endl
+                      << "                             [--max-work <options "
+                      << "x arguments>] [--output <file>]" << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        if (parser.OptionGiven("filter"))
+        {
+            filter = parser.GetOptionString("filter");
+        }
+        if (parser.OptionGiven("min-time"))
+        {
+            parser.GetOptionValue("min-time", min_time, 0.0, 3600.0);
+        }
+        if (parser.OptionGiven("max-work"))
+        {
+            parser.GetOptionValue("max-work", max_work);
+        }
+        if (parser.OptionGiven("output"))
+        {
+            output = parser.GetOptionString("output");
+        }
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    BenchmarkRunner runner(filter, min_time, max_work);
+
+    BenchmarkParseScaling(runner);
+    BenchmarkLongEquals(runner);
+    BenchmarkParseStrategies(runner);
+    BenchmarkShortBundles(runner);
+    BenchmarkCaseInsensitive(runner);
+    BenchmarkQueries(runner);
+    BenchmarkNumericConversions(runner);
+    BenchmarkAdversarial(runner);
+    BenchmarkParserPool(runner);
+    BenchmarkSetOptions(runner);
+
+    if (output.empty())
+    {
+        runner.WriteJSON(std::cout);
+    }
+    else
+    {
+        std::ofstream file(output);
+        if (!file)
+        {
+            std::cerr << "Unable to open output file: " << output << std::endl;
+            return EXIT_FAILURE;
+        }
+        runner.WriteJSON(file);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+/*
+ *  argument_vector.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the ArgumentVector object, which builds a
+ *      command-line for a child process in the form expected by execve() or
+ *      posix_spawn().  The characters of all arguments are held in a single
+ *      contiguous buffer, each followed by a terminating null character, and
+ *      Data() returns a null-terminated array of pointers into that buffer:
+ *
+ *          ArgumentVector child;
+ *
+ *          child.Append("/usr/bin/worker");
+ *          parser.AppendOptions(child, parser.GetOptionMask({"threads"}));
+ *          child.Append({"--threads=", "4"});
+ *
+ *          posix_spawn(&pid, child[0].data(), nullptr, nullptr,
+ *                      child.Data(), environ);
+ *
+ *      Clear() retains the storage, so an object reused to build many
+ *      similar command-lines does not allocate memory once its storage has
+ *      grown to hold the longest of them.  Arguments may be formed from
+ *      arguments already held (e.g., child.Append(child[0])).  Since each
+ *      argument is given to the child as a null-terminated string, an
+ *      argument must not contain a null character.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+namespace Terra::ProgramOptions
+{
+
+// Define a command-line held in a single buffer with an array of pointers
+class ArgumentVector
+{
+    public:
+        ArgumentVector() = default;
+        ~ArgumentVector() = default;
+
+        void Clear() noexcept;
+        void Reserve(std::size_t argument_count, std::size_t character_count);
+        void Append(std::string_view argument);
+        void Append(std::initializer_list<std::string_view> parts);
+        void Extend(std::string_view part);
+
+        // Return the number of arguments
+        std::size_t Size() const noexcept
+        {
+            return offsets.size();
+        }
+
+        // Is the argument vector empty?
+        bool Empty() const noexcept
+        {
+            return offsets.empty();
+        }
+
+        // Return the argument at the given position
+        std::string_view operator[](std::size_t position) const noexcept
+        {
+            const std::size_t end = (position + 1 < offsets.size()) ?
+                                        offsets[position + 1] - 1 :
+                                        buffer.size() - 1;
+
+            return {buffer.data() + offsets[position], end - offsets[position]};
+        }
+
+        char *const *Data();
+
+    protected:
+        std::vector<char> buffer;               // Null-terminated arguments
+        std::vector<std::size_t> offsets;       // Offset of each argument
+        std::vector<char *> pointers;           // Pointers given to Data()
+
+        void AppendCharacters(std::initializer_list<std::string_view> parts);
+};
+
+} // namespace Terra::ProgramOptions
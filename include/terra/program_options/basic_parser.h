@@ -0,0 +1,615 @@
+/*
+ *  basic_parser.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the BasicParser object, which is a Parser whose
+ *      option flags, option value separator, and case sensitivity are
+ *      provided at compile time via a policy type rather than at runtime.
+ *      Since these are compile-time constants, the loops that match
+ *      arguments against program options contain no branches related to
+ *      the parser configuration and the compiler is able to inline the flag
+ *      and separator comparisons.
+ *
+ *      A policy is a type having the following static members:
+ *
+ *          case_insensitive        - bool indicating case insensitivity
+ *          short_flags             - range of strings used as short flags
+ *          long_flags              - range of strings used as long flags
+ *          option_value_separator  - string separating long options / values
+ *
+ *      For example, a parser for DOS-style options like "/A:D" might be
+ *      defined as follows:
+ *
+ *          struct DOSPolicy
+ *          {
+ *              static constexpr bool case_insensitive = true;
+ *              static constexpr std::array<std::string_view, 0> short_flags{};
+ *              static constexpr std::array<std::string_view, 1> long_flags{
+ *                  "/"};
+ *              static constexpr std::string_view option_value_separator{":"};
+ *          };
+ *
+ *          Terra::ProgramOptions::BasicParser<DOSPolicy> parser(options);
+ *
+ *      Aside from construction and SetOptions(), a BasicParser is used in
+ *      exactly the same way as a Parser.  Since the flags, separator, and
+ *      case sensitivity are fixed by the policy, calling the Parser's
+ *      SetOptions() (e.g., via a reference to the Parser) with any others
+ *      throws a SpecificationException.  The Parser object itself remains
+ *      the runtime-configured parser; it shares the same matching code,
+ *      selecting the case-sensitive or case-insensitive instantiation once
+ *      per argument.
+ *
+ *      This file also contains the definitions of the Parser member
+ *      templates used to match arguments, so it must be included by any
+ *      code that instantiates them.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "program_options.h"
+#include "case_fold.h"
+
+namespace Terra::ProgramOptions
+{
+
+// Define a concept for types that may be used as a BasicParser policy
+template<typename T>
+concept ParserPolicy = requires
+{
+    { T::case_insensitive } -> std::convertible_to<bool>;
+    requires std::ranges::input_range<decltype(T::short_flags)>;
+    requires std::ranges::input_range<decltype(T::long_flags)>;
+    { std::string_view(T::option_value_separator) };
+};
+
+// Default policy using "-" and "--" flags and "=" as the value separator
+struct DefaultPolicy
+{
+    static constexpr bool case_insensitive = false;
+    static constexpr std::array<std::string_view, 1> short_flags{"-"};
+    static constexpr std::array<std::string_view, 1> long_flags{"--"};
+    static constexpr std::string_view option_value_separator{"="};
+};
+
+// Default policy, but with program option names matched case insensitively
+struct CaseInsensitivePolicy : public DefaultPolicy
+{
+    static constexpr bool case_insensitive = true;
+};
+
+// Policy used by the Parser to refer to its runtime configuration
+template<bool CaseInsensitive>
+struct RuntimePolicy
+{
+    static constexpr bool case_insensitive = CaseInsensitive;
+    const std::vector<std::string> &short_flags;
+    const std::vector<std::string> &long_flags;
+    const std::string &option_value_separator;
+};
+
+// Define the parser having a compile-time configuration
+template<ParserPolicy Policy = DefaultPolicy>
+class BasicParser : public Parser
+{
+    public:
+        BasicParser() : BasicParser(Options{})
+        {
+        }
+        explicit BasicParser(Options options) :
+            Parser(std::move(options),
+                   FlagStrings(Policy::short_flags),
+                   FlagStrings(Policy::long_flags),
+                   std::string(Policy::option_value_separator),
+                   Policy::case_insensitive)
+        {
+        }
+        BasicParser(const BasicParser &parser) = default;
+        BasicParser(BasicParser &&parser) noexcept = default;
+        virtual ~BasicParser() = default;
+
+        BasicParser &operator=(const BasicParser &parser) = default;
+        BasicParser &operator=(BasicParser &&parser) = default;
+
+        void SetOptions(const Options &options)
+        {
+            Parser::SetOptions(options,
+                               FlagStrings(Policy::short_flags),
+                               FlagStrings(Policy::long_flags),
+                               std::string(Policy::option_value_separator),
+                               Policy::case_insensitive);
+        }
+
+        // The flags, separator, and case sensitivity are given by the policy,
+        // so they may not be changed (e.g., via a reference to the Parser)
+        void SetOptions(const Options &options,
+                        const std::vector<std::string> &short_flags,
+                        const std::vector<std::string> &long_flags,
+                        const std::string &option_value_separator,
+                        const bool case_insensitive) override
+        {
+            if (!std::ranges::equal(short_flags, Policy::short_flags) ||
+                !std::ranges::equal(long_flags, Policy::long_flags) ||
+                (option_value_separator !=
+                 std::string_view(Policy::option_value_separator)) ||
+                (case_insensitive != Policy::case_insensitive))
+            {
+                throw SpecificationException(
+                            "Option flags differ from the parser policy",
+                            OptionsError::FlagConflict);
+            }
+
+            SetOptions(options);
+        }
+
+    protected:
+        bool ProcessArgument(
+                    const std::string_view argument,
+                    const std::optional<std::string_view> &parameter) override
+        {
+            return MatchArgument(Policy{}, argument, parameter);
+        }
+
+        template<typename Flags>
+        static std::vector<std::string> FlagStrings(const Flags &flags)
+        {
+            std::vector<std::string> strings;
+
+            for (const auto &flag : flags) strings.emplace_back(flag);
+
+            return strings;
+        }
+};
+
+/*
+ *  Parser::MatchArgument()
+ *
+ *  Description:
+ *      This function will consider the provided argument and determine if it
+ *      is a long option argument, a short option argument, or just a string on
+ *      the command-line, using the flags, separator, and case sensitivity
+ *      given by the policy.  See ProcessArgument() for details.
+ *
+ *  Parameters:
+ *      policy [in]
+ *          The policy providing the parser configuration.
+ *
+ *      argument [in]
+ *          The argument to process.
+ *
+ *      parameter [in]
+ *          A possible parameter for an argument that expect a parameter to
+ *          follow.
+ *
+ *  Returns:
+ *      True if the parameter was consumed when processing the argument, false
+ *      otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Policy>
+bool Parser::MatchArgument(const Policy &policy,
+                           const std::string_view argument,
+                           const std::optional<std::string_view> &parameter)
+{
+    // If the argument is zero-length, no point checking for options
+    if (!argument.empty())
+    {
+        // Try to process the argument by considering long option formats first
+        auto [long_option_matched, long_parameter_consumed] =
+                                MatchLongOption(policy, argument, parameter);
+
+        if (long_option_matched) return long_parameter_consumed;
+
+        // Try to process the argument by considering short option formats
+        auto [short_option_matched, short_parameter_consumed] =
+                                MatchShortOption(policy, argument, parameter);
+
+        if (short_option_matched) return short_parameter_consumed;
+    }
+
+    // Since neither the long or short option was matched, the argument will
+    // be added to the list of strings
+    StoreArgument(argument);
+
+    return false;
+}
+
+/*
+ *  Parser::MatchLongOption()
+ *
+ *  Description:
+ *      This function consider the provided argument and determine if it is a
+ *      long option argument.  If it is and the option consumes the provided
+ *      additional parameter, that will be noted in the return value.  If it
+ *      appears to be a long option based on flags, but it does not match any
+ *      option, an exception will be thrown (unless unknown options are passed
+ *      through).  If it appears to match a long
+ *      option flag and only the flags (e.g., "--"), it will be treated as a
+ *      string and stored with the strings under the option name "".
+ *
+ *  Parameters:
+ *      policy [in]
+ *          The policy providing the parser configuration.
+ *
+ *      argument [in]
+ *          The argument to process.
+ *
+ *      parameter [in]
+ *          A possible parameter for an argument that expect a parameter to
+ *          follow.
+ *
+ *  Returns:
+ *      A pair of bool values, the first being true if the argument was
+ *      processed as a long option argument and false if it was not processed
+ *      as a long option argument.  If processed, the second bool indicates
+ *      whether the optional parameter was also consumed as a parameter to the
+ *      option or if it should be separately considered.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Policy>
+std::pair<bool, bool> Parser::MatchLongOption(
+                            const Policy &policy,
+                            const std::string_view argument,
+                            const std::optional<std::string_view> &parameter)
+{
+    // Offset of the option name within the argument
+    std::size_t name_offset = 0;
+
+    // Find the start of the option (beyond the options strings (e.g., "--")),
+    // returning if no flags found
+    if (!FindOptionStart(policy.long_flags, argument, name_offset))
+    {
+        return {false, false};
+    }
+
+    // If there are no other characters in the argument, then we matched only
+    // flag characters (e.g., "--"); accept that as string by storing it with
+    // the other strings and returning
+    if (name_offset == argument.length())
+    {
+        StoreArgument(argument);
+        return {true, false};
+    }
+
+    // Get the option name portion of the argument, folding its case once if
+    // options are case insensitive (folding does not alter the length, so
+    // offsets into the folded string refer to the original argument)
+    std::string_view option_string = argument.substr(name_offset);
+    if constexpr (Policy::case_insensitive)
+    {
+        FoldCase(option_string, folded_argument, unicode_folding);
+        option_string = folded_argument;
+    }
+
+    // Get the option value separator (e.g., "=")
+    const std::string_view separator(policy.option_value_separator);
+
+    // Index and name length of the matched option
+    std::size_t matched_index = No_Option_Index;
+    std::size_t matched_length = 0;
+
+    // Walk the trie of long option names; at each node where an option name
+    // ends, the option matches if the argument also ends there or if the
+    // option value separator follows (e.g., "foo=bar").  If several options
+    // match, the first one in the options vector is used.
+    std::uint32_t node = 0;
+    for (std::size_t i = 0; node != No_Node_Index; i++)
+    {
+        const std::size_t option_index = long_option_nodes[node].option_index;
+
+        if ((option_index < matched_index) &&
+            ((i == option_string.length()) ||
+             argument.substr(name_offset + i).starts_with(separator)))
+        {
+            matched_index = option_index;
+            matched_length = i;
+        }
+
+        if (i == option_string.length()) break;
+
+        node = FindLongOptionNode(node, option_string[i]);
+    }
+
+    if (matched_index != No_Option_Index)
+    {
+        // Did we precisely match the name?
+        if (matched_length == option_string.length())
+        {
+            // Store the command line option, noting if parameter is consumed
+            return {true, StoreOption(matched_index, parameter)};
+        }
+
+        // This is a command-line option like "--foo=bar", so the parameter
+        // is the rest of the string
+        StoreOptionValue(matched_index,
+                         argument,
+                         argument.substr(name_offset + matched_length +
+                                         separator.length()));
+
+        return {true, false};
+    }
+
+    // If we could not match an option, pass it through (taking a value only
+    // if one is not included in the argument) or raise an exception
+    if (unknown_options != UnknownOptions::Reject)
+    {
+        return {true,
+                StoreUnknownOption(
+                    (argument.find(separator, name_offset) ==
+                     std::string_view::npos) &&
+                    parameter.has_value() &&
+                    !AppearsToBeOption(policy, *parameter))};
+    }
+
+    ThrowInvalidOption(argument, OptionsError::InvalidLongOption);
+}
+
+/*
+ *  Parser::MatchShortOption()
+ *
+ *  Description:
+ *      This function consider the provided argument and determine if it is a
+ *      short option argument.  If it is and the option consumes the provided
+ *      additional parameter, that will be noted in the return value.  If it
+ *      appears to be a short option based on flags, but it does not match any
+ *      option, an exception will be thrown (unless unknown options are passed
+ *      through).  If it appears to match a short
+ *      option flag and only the flags (e.g., "-"), it will be treated as a
+ *      string and stored with the strings under the option name "".
+ *
+ *  Parameters:
+ *      policy [in]
+ *          The policy providing the parser configuration.
+ *
+ *      argument [in]
+ *          The argument to process.
+ *
+ *      parameter [in]
+ *          A possible parameter for an argument that expect a parameter to
+ *          follow.
+ *
+ *  Returns:
+ *      A pair of bool values, the first being true if the argument was
+ *      processed as a short option argument and false if it was not processed
+ *      as a short option argument.  If processed, the second bool indicates
+ *      whether the optional parameter was also consumed as a parameter to the
+ *      option or if it should be separately considered.
+ *
+ *  Comments:
+ *      Case insensitivity is handled by the short option table, which holds
+ *      both the lowercase and uppercase forms of each option character.
+ */
+template<typename Policy>
+std::pair<bool, bool> Parser::MatchShortOption(
+                            const Policy &policy,
+                            const std::string_view argument,
+                            const std::optional<std::string_view> &parameter)
+{
+    // Offset of the current option character within the argument
+    std::size_t offset = 0;
+
+    // Indicate whether parameter was consumed
+    bool parameter_consumed = false;
+
+    // Find the start of the option (beyond the options strings (e.g., "-")),
+    // returning if no flags found
+    if (!FindOptionStart(policy.short_flags, argument, offset))
+    {
+        return {false, false};
+    }
+
+    // If there are no other characters in the argument, then we matched only
+    // flag characters (e.g., "-"); accept that as string by storing it with
+    // the other strings and returning
+    if (offset == argument.length())
+    {
+        StoreArgument(argument);
+        return {true, false};
+    }
+
+    // If passing unknown options through, an argument having any unknown
+    // option character is passed through whole, storing none of its options
+    if (unknown_options != UnknownOptions::Reject)
+    {
+        for (std::size_t i = offset; i < argument.length(); i++)
+        {
+            if (short_option_index[static_cast<unsigned char>(argument[i])] ==
+                No_Option_Index)
+            {
+                return {true,
+                        StoreUnknownOption(
+                            parameter.has_value() &&
+                            !AppearsToBeOption(policy, *parameter))};
+            }
+        }
+    }
+
+    // Iterate over the characters in the option string
+    for (; offset < argument.length(); offset++)
+    {
+        // Look up the option associated with the character
+        const std::size_t index =
+                short_option_index[static_cast<unsigned char>(argument[offset])];
+
+        // If we could not match an option, raise an exception
+        if (index == No_Option_Index)
+        {
+            ThrowInvalidOption(argument, OptionsError::InvalidShortOption);
+        }
+
+        // Only the final option character may consume the parameter
+        if ((offset + 1) == argument.length())
+        {
+            // Store the command-line option, noting if parameter is consumed
+            parameter_consumed = StoreOption(index, parameter);
+        }
+        else
+        {
+            // Store the command-line option, passing an empty optional
+            // parameter
+            StoreOption(index, {});
+        }
+    }
+
+    return {true, parameter_consumed};
+}
+
+/*
+ *  Parser::FindLongOptionNode()
+ *
+ *  Description:
+ *      This function will return the child of the given node in the trie of
+ *      long option names that is reached via the given character.
+ *
+ *  Parameters:
+ *      node [in]
+ *          The index of the parent node.
+ *
+ *      c [in]
+ *          The character labeling the edge to follow.
+ *
+ *  Returns:
+ *      The index of the child node or No_Node_Index if there is none.
+ *
+ *  Comments:
+ *      The edges are sorted, so this function is O(log n) for a node having
+ *      n children.
+ */
+inline std::uint32_t Parser::FindLongOptionNode(std::uint32_t node,
+                                                char c) const
+{
+    const auto first = long_option_edge_labels.begin() +
+                                        long_option_nodes[node].first_edge;
+    const auto last = first + long_option_nodes[node].edge_count;
+    const auto label = static_cast<unsigned char>(c);
+
+    const auto it = std::lower_bound(
+                            first,
+                            last,
+                            label,
+                            [](char edge_label, unsigned char value)
+                            {
+                                return static_cast<unsigned char>(edge_label) <
+                                       value;
+                            });
+
+    if ((it == last) || (static_cast<unsigned char>(*it) != label))
+    {
+        return No_Node_Index;
+    }
+
+    return long_option_edge_targets[static_cast<std::size_t>(
+                                    it - long_option_edge_labels.begin())];
+}
+
+/*
+ *  Parser::FindOptionStart()
+ *
+ *  Description:
+ *      This function will accept a range of strings containing option flags
+ *      (e.g., "--") and try to find the start of the argument beyond those
+ *      flags.
+ *
+ *  Parameters:
+ *      flags [in]
+ *          Range of option flags to evaluate.
+ *
+ *      argument [in]
+ *          The command-line argument.
+ *
+ *      offset [out]
+ *          The offset of the first character after the option flags (i.e.,
+ *          the actual argument name) if flags are found.
+ *
+ *  Returns:
+ *      True if flags were found and false if no flags were found.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename Flags>
+bool Parser::FindOptionStart(const Flags &flags,
+                             const std::string_view argument,
+                             std::size_t &offset)
+{
+    // If the argument is empty, there is nothing to find
+    if (argument.empty()) return false;
+
+    // Consider each possible flag string (e.g., "--")
+    for (const auto &flag : flags)
+    {
+        const std::string_view flag_string(flag);
+
+        if (argument.starts_with(flag_string))
+        {
+            offset = flag_string.length();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ *  Parser::AppearsToBeOption()
+ *
+ *  Description:
+ *      This function will determine whether the given argument appears to
+ *      be an option (or a terminator) rather than a value.
+ *
+ *  Parameters:
+ *      policy [in]
+ *          The policy providing the parser configuration.
+ *
+ *      argument [in]
+ *          The argument to examine.
+ *
+ *  Returns:
+ *      True if the argument begins with a long flag or begins with a short
+ *      flag followed by other characters, or if it is a terminator.  An
+ *      argument consisting only of a short flag (e.g., "-") is a value.
+ *
+ *  Comments:
+ *      Values beginning with a flag (e.g., a negative number) are therefore
+ *      not taken as the value of an unknown option.  The flags are those of
+ *      the policy, so this agrees with the matching of options.
+ */
+template<typename Policy>
+bool Parser::AppearsToBeOption(const Policy &policy,
+                               const std::string_view argument) const
+{
+    std::size_t offset = 0;
+
+    if (std::ranges::find(terminators, argument) != terminators.end())
+    {
+        return true;
+    }
+
+    if (FindOptionStart(policy.long_flags, argument, offset)) return true;
+
+    return FindOptionStart(policy.short_flags, argument, offset) &&
+           (offset < argument.length());
+}
+
+} // namespace Terra::ProgramOptions
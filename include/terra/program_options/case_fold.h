@@ -0,0 +1,75 @@
+/*
+ *  case_fold.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the case folding functions used by the Parser when
+ *      program options are matched case insensitively.  Folding maps
+ *      characters to their lowercase form and does not depend on the C
+ *      locale, so results do not change if a program calls setlocale().
+ *
+ *      ASCII characters are folded using a table lookup.  Non-ASCII UTF-8
+ *      characters may optionally be folded using Unicode simple case folding
+ *      (full case folding, such as "ß" to "ss", is not performed).  Only
+ *      mappings that do not change the encoded length of a character are
+ *      applied (this covers two-octet characters in the Latin-1 Supplement,
+ *      Latin Extended-A, Greek, Cyrillic, and Armenian blocks), so a folded
+ *      string always has the same length as the input and offsets into the
+ *      folded string refer to the same characters in the original string.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+
+namespace Terra::ProgramOptions
+{
+
+// Table mapping each octet to its ASCII case-folded (lowercase) form
+inline constexpr std::array<char, 256> ASCII_Fold_Table = []()
+{
+    std::array<char, 256> table{};
+
+    for (std::size_t i = 0; i < table.size(); i++)
+    {
+        table[i] = static_cast<char>(((i >= 'A') && (i <= 'Z')) ? i + 32 : i);
+    }
+
+    return table;
+}();
+
+// Fold a single character using the ASCII table
+constexpr char FoldASCII(char c) noexcept
+{
+    return ASCII_Fold_Table[static_cast<unsigned char>(c)];
+}
+
+// Returns true if the string contains any non-ASCII characters
+constexpr bool ContainsNonASCII(std::string_view input) noexcept
+{
+    for (const auto c : input)
+    {
+        if (static_cast<unsigned char>(c) & 0x80) return true;
+    }
+
+    return false;
+}
+
+// Fold the input string into the output string (replacing its contents)
+void FoldCase(std::string_view input, std::string &output, bool unicode);
+
+// Return a case-folded copy of the given string
+std::string FoldCase(std::string_view input, bool unicode);
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,58 @@
+/*
+ *  fingerprint.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the Fingerprint object, which computes a 64-bit
+ *      hash over a sequence of strings and integers.  It is used to produce
+ *      fingerprints of option specifications, argument vectors, and parsed
+ *      results that may be used as cache keys.
+ *
+ *      Input is consumed eight octets at a time using a multiply-and-xorshift
+ *      mixing function similar to MurmurHash64A, so hashing is fast even for
+ *      long arguments.  Each string is preceded by its length, so sequences
+ *      of strings that concatenate to the same octets (e.g., "ab", "c" and
+ *      "a", "bc") produce different fingerprints.  Octets are always read in
+ *      little-endian order, so a fingerprint is the same on every platform
+ *      and in every release of this library; it may therefore be stored or
+ *      transmitted.  Fingerprints are not cryptographic and must not be
+ *      relied upon where an adversary might construct collisions; hash
+ *      tables indexing user input use KeyedHash() instead.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Terra::ProgramOptions
+{
+
+// Define an object to compute a stable 64-bit fingerprint
+class Fingerprint
+{
+    public:
+        explicit Fingerprint(std::uint64_t seed = 0) noexcept;
+        ~Fingerprint() = default;
+
+        void Update(std::string_view data) noexcept;
+        void Update(std::uint64_t value) noexcept;
+
+        std::uint64_t Value() const noexcept;
+
+    protected:
+        void Mix(std::uint64_t block) noexcept;
+
+        std::uint64_t state;
+};
+
+} // namespace Terra::ProgramOptions
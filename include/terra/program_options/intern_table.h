@@ -0,0 +1,102 @@
+/*
+ *  intern_table.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the InternTable object, which holds a single copy
+ *      of each distinct string given to it and identifies each string by an
+ *      InternedValue handle.  A table may be given to a Parser (and so shared
+ *      by copies of the Parser, such as those held by a ParserPool or a
+ *      ParseCache), in which case the values of options are stored as
+ *      handles and identical values given in any option of any parse are
+ *      kept once:
+ *
+ *          auto table = std::make_shared<Terra::ProgramOptions::InternTable>();
+ *
+ *          parser.SetInternTable(table);
+ *
+ *      Two handles from the same table are equal if and only if the strings
+ *      are equal, so values may be compared without comparing strings.
+ *      Strings are never removed from a table, so views of interned strings
+ *      remain valid for the life of the table.  A table is intended for
+ *      long-running programs that parse many command-lines having values in
+ *      common (e.g., paths, host names, or queue names); since it grows with
+ *      each distinct value, it should not be used with unbounded sets of
+ *      values.
+ *
+ *      The table may be used by multiple threads concurrently.  Looking up
+ *      a string that is already interned requires only a shared lock and
+ *      does not allocate memory.  Strings are indexed using KeyedHash(), so
+ *      a long-lived table shared by many parses cannot be filled with
+ *      strings crafted to collide and make each lookup slow.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <terra/program_options/keyed_hash.h>
+
+namespace Terra::ProgramOptions
+{
+
+// Define a handle identifying a string held in an InternTable
+struct InternedValue
+{
+    std::uint32_t id;                           // Index of the string
+
+    bool operator==(const InternedValue &other) const = default;
+};
+
+// Define a table holding a single copy of each distinct string
+class InternTable
+{
+    public:
+        InternTable() = default;
+        InternTable(const InternTable &) = delete;
+        ~InternTable() = default;
+
+        InternTable &operator=(const InternTable &) = delete;
+
+        InternedValue Intern(std::string_view value);
+        std::optional<InternedValue> Find(std::string_view value) const;
+        std::string_view View(InternedValue handle) const;
+        std::size_t Size() const;
+
+    protected:
+        // Hash of the strings in the index
+        struct KeyedStringHash
+        {
+            std::size_t operator()(std::string_view value) const noexcept
+            {
+                return static_cast<std::size_t>(KeyedHash(value));
+            }
+        };
+
+        // Mutex protecting the strings and the index
+        mutable std::shared_mutex mutex;
+
+        // Interned strings, which are never moved once inserted
+        std::deque<std::string> strings;
+
+        // Index of the strings by value
+        std::unordered_map<std::string_view, std::uint32_t, KeyedStringHash>
+                                                                    index;
+};
+
+} // namespace Terra::ProgramOptions
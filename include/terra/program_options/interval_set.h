@@ -0,0 +1,179 @@
+/*
+ *  interval_set.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the Interval type and the IntervalSet object, which
+ *      hold the values given for an option having the value type
+ *      ValueType::IntervalSet (e.g., "--cpus=0-15,32-47").
+ *
+ *      The intervals of a set are kept sorted, and overlapping or adjacent
+ *      intervals are merged as they are inserted, so the memory used is
+ *      proportional to the number of disjoint intervals rather than the
+ *      number of members, and membership is determined using a binary search
+ *      in O(log n) time.
+ *
+ *      An IntervalSet is a view of intervals held by a Parser and remains
+ *      valid until options are cleared or arguments are parsed again.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace Terra::ProgramOptions
+{
+
+// Define an interval of unsigned values [lower, upper]
+struct Interval
+{
+    std::uint64_t lower;                        // Lowest member
+    std::uint64_t upper;                        // Highest member
+
+    bool operator==(const Interval &other) const = default;
+};
+
+// Define a view of a sorted set of disjoint, non-adjacent intervals
+class IntervalSet
+{
+    public:
+        IntervalSet() = default;
+        explicit IntervalSet(std::span<const Interval> intervals) noexcept :
+            intervals{intervals}
+        {
+        }
+
+        // Is the given value a member of any interval?
+        bool Contains(std::uint64_t value) const noexcept
+        {
+            // Find the first interval ending at or above the value
+            auto it = std::lower_bound(
+                intervals.begin(),
+                intervals.end(),
+                value,
+                [](const Interval &interval, std::uint64_t value)
+                {
+                    return interval.upper < value;
+                });
+
+            return (it != intervals.end()) && (it->lower <= value);
+        }
+
+        // Return the intervals in ascending order
+        std::span<const Interval> Intervals() const noexcept
+        {
+            return intervals;
+        }
+
+        // Return the number of disjoint intervals
+        std::size_t Size() const noexcept
+        {
+            return intervals.size();
+        }
+
+        bool Empty() const noexcept
+        {
+            return intervals.empty();
+        }
+
+    protected:
+        std::span<const Interval> intervals;
+};
+
+// Insert the given interval into a sorted vector of disjoint, non-adjacent
+// intervals, merging it with any intervals it overlaps or adjoins
+inline void InsertInterval(std::vector<Interval> &intervals,
+                           Interval interval)
+{
+    constexpr std::uint64_t Max = std::numeric_limits<std::uint64_t>::max();
+
+    // Find the first interval that is not entirely below the new interval
+    // (an interval ending just below it adjoins it)
+    auto first = std::lower_bound(
+        intervals.begin(),
+        intervals.end(),
+        interval.lower,
+        [](const Interval &existing, std::uint64_t lower)
+        {
+            return (existing.upper < lower) && (existing.upper + 1 < lower);
+        });
+
+    // Extend the new interval over each interval it overlaps or adjoins
+    auto last = first;
+    while ((last != intervals.end()) &&
+           ((last->lower <= interval.upper) ||
+            ((interval.upper != Max) && (last->lower == interval.upper + 1))))
+    {
+        interval.lower = std::min(interval.lower, last->lower);
+        interval.upper = std::max(interval.upper, last->upper);
+        ++last;
+    }
+
+    // Replace the merged intervals with the new interval
+    if (first == last)
+    {
+        intervals.insert(first, interval);
+    }
+    else
+    {
+        *first = interval;
+        intervals.erase(first + 1, last);
+    }
+}
+
+// Merge the intervals following the first sorted_count intervals, which are
+// sorted, disjoint, and non-adjacent, into those intervals; sorting only the
+// new intervals and merging them in a single pass keeps the cost of adding
+// many intervals at once to O(n log n) rather than O(n^2)
+inline void MergeIntervals(std::vector<Interval> &intervals,
+                           std::size_t sorted_count)
+{
+    constexpr std::uint64_t Max = std::numeric_limits<std::uint64_t>::max();
+
+    if (sorted_count >= intervals.size()) return;
+
+    const auto by_lower = [](const Interval &a, const Interval &b)
+    {
+        return a.lower < b.lower;
+    };
+
+    std::sort(intervals.begin() + sorted_count, intervals.end(), by_lower);
+    std::inplace_merge(intervals.begin(),
+                       intervals.begin() + sorted_count,
+                       intervals.end(),
+                       by_lower);
+
+    // Coalesce intervals that overlap or adjoin the preceding interval
+    std::size_t last = 0;
+    for (std::size_t i = 1; i < intervals.size(); i++)
+    {
+        Interval &merged = intervals[last];
+
+        if ((intervals[i].lower <= merged.upper) ||
+            ((merged.upper != Max) && (intervals[i].lower == merged.upper + 1)))
+        {
+            merged.upper = std::max(merged.upper, intervals[i].upper);
+        }
+        else
+        {
+            intervals[++last] = intervals[i];
+        }
+    }
+    intervals.resize(last + 1);
+}
+
+} // namespace Terra::ProgramOptions
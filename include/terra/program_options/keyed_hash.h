@@ -0,0 +1,40 @@
+/*
+ *  keyed_hash.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the KeyedHash() functions, which compute a 64-bit
+ *      SipHash-1-3 of a string or integer using a 128-bit key chosen at
+ *      random when first used in the process.  They are used to index the
+ *      hash tables that hold user input (e.g., map keys and deduplicated
+ *      values), since an adversary who cannot learn the key cannot construct
+ *      inputs that all select the same entries of a table.
+ *
+ *      Unlike a Fingerprint, a keyed hash differs from one process to the
+ *      next, so it must not be stored, transmitted, or used as a cache key.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace Terra::ProgramOptions
+{
+
+// Compute a keyed 64-bit hash of the given string
+std::uint64_t KeyedHash(std::string_view data) noexcept;
+
+// Compute a keyed 64-bit hash of the given integer
+std::uint64_t KeyedHash(std::uint64_t value) noexcept;
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,393 @@
+/*
+ *  option_binding.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the OptionBinding interface and the Bind() functions
+ *      used to bind a program option to a variable (or a member of a
+ *      structure).  Values given for a bound option are converted, checked
+ *      against the bounds given when binding, and stored directly into the
+ *      variable as the arguments are parsed, so no strings are retained for
+ *      the option and no lookup by name is needed to retrieve the value:
+ *
+ *          Settings settings;
+ *
+ *          Terra::ProgramOptions::Options options =
+ *          {
+ *              { "level", "l", "level", false, true,
+ *                Bind(settings.level, 0u, 9u, 6u) },
+ *              { "verbose", "v", "verbose", true, false,
+ *                Bind(settings.verbosity) },
+ *              { "exclude", "x", "exclude", true, true,
+ *                Bind(settings.excludes) }
+ *          };
+ *
+ *      The following types of variables may be bound:
+ *
+ *          - Numeric types (including bool), optionally with bounds; a value
+ *            given multiple times replaces the previous value
+ *          - std::string
+ *          - std::vector of the above, to which each value is appended (the
+ *            vector is cleared when arguments are parsed)
+ *
+ *      A default value may be given, which is assigned to the variable if the
+ *      option is not given.  Otherwise, the variable is left unchanged.
+ *
+ *      An option having choices may be bound to an enumeration (or integral)
+ *      variable using BindChoice(), which assigns the index of the choice
+ *      given converted to the variable's type, so the enumerators should be
+ *      listed in the same order as the choices.  Binding such an option with
+ *      Bind() stores the value as given, as for other options.
+ *
+ *      Options that do not expect a value may be bound to a bool, which is
+ *      set to true if the option is given, or to an integral variable, which
+ *      is assigned the number of times the option was given (e.g., a
+ *      verbosity level).
+ *
+ *      Bound variables must outlive any Parser using the options and are
+ *      written to by ParseArguments(), so a Parser with bound options should
+ *      not be shared by threads parsing concurrently (including via a
+ *      ParserPool).  Since a ParseCache does not parse arguments it has seen
+ *      before, bound variables are not assigned on a cache hit.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "program_options.h"
+#include "value_conversion.h"
+
+namespace Terra::ProgramOptions
+{
+
+// Define a concept for the types of values that may be bound to an option
+template<typename T>
+concept BindableType = NumericType<T> || std::same_as<T, std::string>;
+
+// Define the interface used by the Parser to store values into a variable
+class OptionBinding
+{
+    public:
+        virtual ~OptionBinding() = default;
+
+        // Prepare the variable before arguments are parsed
+        virtual void Prepare() const = 0;
+
+        // Store a value given for the option
+        virtual void Store(std::string_view value) const = 0;
+
+        // Store a value matching the choice having the given index
+        virtual void StoreChoice(std::size_t, std::string_view value) const
+        {
+            Store(value);
+        }
+
+        // Must the option have choices?
+        virtual bool RequiresChoices() const
+        {
+            return false;
+        }
+
+        // Can the number of times an option was given be stored?
+        virtual bool AcceptsCount() const = 0;
+
+        // Store the number of times an option without a value was given
+        virtual void StoreCount(std::size_t count) const = 0;
+
+        // Assign the default value (if any) when the option is not given
+        virtual void ApplyDefault() const = 0;
+};
+
+// Define the binding of an option to a single variable of type T
+template<BindableType T>
+class ValueBinding : public OptionBinding
+{
+    public:
+        ValueBinding(T &target,
+                     T min,
+                     T max,
+                     std::optional<T> default_value) :
+            target{target},
+            min{std::move(min)},
+            max{std::move(max)},
+            default_value{std::move(default_value)}
+        {
+        }
+
+        void Prepare() const override
+        {
+        }
+
+        void Store(std::string_view value) const override
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                target.assign(value);
+            }
+            else
+            {
+                target = ConvertValue(value, min, max);
+            }
+        }
+
+        bool AcceptsCount() const override
+        {
+            return std::is_integral_v<T>;
+        }
+
+        void StoreCount(std::size_t count) const override
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                target = (count > 0);
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                // Widen the bounds, as character types cannot be compared
+                // via std::cmp_less()
+                using Wide = std::conditional_t<std::is_signed_v<T>,
+                                                long long,
+                                                unsigned long long>;
+
+                if (std::cmp_less(count, Wide(min)) ||
+                    std::cmp_greater(count, Wide(max)))
+                {
+                    ThrowRangeError(min, max);
+                }
+                target = static_cast<T>(count);
+            }
+            else
+            {
+                throw std::invalid_argument("option requires a value");
+            }
+        }
+
+        void ApplyDefault() const override
+        {
+            if (default_value) target = *default_value;
+        }
+
+    protected:
+        T &target;
+        const T min;
+        const T max;
+        const std::optional<T> default_value;
+};
+
+// Define the binding of an option to a vector of values of type T
+template<BindableType T>
+class VectorBinding : public OptionBinding
+{
+    public:
+        VectorBinding(std::vector<T> &target,
+                      T min,
+                      T max,
+                      std::optional<std::vector<T>> default_value) :
+            target{target},
+            min{std::move(min)},
+            max{std::move(max)},
+            default_value{std::move(default_value)}
+        {
+        }
+
+        void Prepare() const override
+        {
+            target.clear();
+        }
+
+        void Store(std::string_view value) const override
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                target.emplace_back(value);
+            }
+            else
+            {
+                target.push_back(ConvertValue(value, min, max));
+            }
+        }
+
+        bool AcceptsCount() const override
+        {
+            return false;
+        }
+
+        void StoreCount(std::size_t) const override
+        {
+            throw std::invalid_argument("option requires a value");
+        }
+
+        void ApplyDefault() const override
+        {
+            if (default_value) target = *default_value;
+        }
+
+    protected:
+        std::vector<T> &target;
+        const T min;
+        const T max;
+        const std::optional<std::vector<T>> default_value;
+};
+
+// Define the binding of an option having choices to a variable of type T,
+// to which the index of the choice given is assigned
+template<typename T>
+    requires std::is_enum_v<T> || std::is_integral_v<T>
+class ChoiceBinding : public OptionBinding
+{
+    public:
+        ChoiceBinding(T &target, std::optional<T> default_value) :
+            target{target},
+            default_value{std::move(default_value)}
+        {
+        }
+
+        void Prepare() const override
+        {
+        }
+
+        void Store(std::string_view) const override
+        {
+            throw std::invalid_argument("option has no choices");
+        }
+
+        void StoreChoice(std::size_t index, std::string_view) const override
+        {
+            target = static_cast<T>(index);
+        }
+
+        bool RequiresChoices() const override
+        {
+            return true;
+        }
+
+        bool AcceptsCount() const override
+        {
+            return false;
+        }
+
+        void StoreCount(std::size_t) const override
+        {
+            throw std::invalid_argument("option requires a value");
+        }
+
+        void ApplyDefault() const override
+        {
+            if (default_value) target = *default_value;
+        }
+
+    protected:
+        T &target;
+        const std::optional<T> default_value;
+};
+
+// Bind an option to a variable, with an optional default value
+template<BindableType T>
+std::shared_ptr<const OptionBinding> Bind(
+                    T &target,
+                    std::optional<std::type_identity_t<T>> default_value = {})
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return std::make_shared<ValueBinding<T>>(target,
+                                                 T{},
+                                                 T{},
+                                                 std::move(default_value));
+    }
+    else
+    {
+        return std::make_shared<ValueBinding<T>>(
+                                            target,
+                                            std::numeric_limits<T>::lowest(),
+                                            std::numeric_limits<T>::max(),
+                                            std::move(default_value));
+    }
+}
+
+// Bind an option to a numeric variable having the given bounds, with an
+// optional default value
+template<NumericType T>
+std::shared_ptr<const OptionBinding> Bind(
+                    T &target,
+                    std::type_identity_t<T> min,
+                    std::type_identity_t<T> max,
+                    std::optional<std::type_identity_t<T>> default_value = {})
+{
+    return std::make_shared<ValueBinding<T>>(target,
+                                             min,
+                                             max,
+                                             std::move(default_value));
+}
+
+// Bind an option to a vector to which each value given is appended, with an
+// optional default value
+template<BindableType T>
+std::shared_ptr<const OptionBinding> Bind(
+        std::vector<T> &target,
+        std::optional<std::vector<T>> default_value = {})
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return std::make_shared<VectorBinding<T>>(target,
+                                                  T{},
+                                                  T{},
+                                                  std::move(default_value));
+    }
+    else
+    {
+        return std::make_shared<VectorBinding<T>>(
+                                            target,
+                                            std::numeric_limits<T>::lowest(),
+                                            std::numeric_limits<T>::max(),
+                                            std::move(default_value));
+    }
+}
+
+// Bind an option to a vector to which each value given is appended, where
+// each value must be within the given bounds
+template<NumericType T>
+std::shared_ptr<const OptionBinding> Bind(
+        std::vector<T> &target,
+        std::type_identity_t<T> min,
+        std::type_identity_t<T> max,
+        std::optional<std::vector<T>> default_value = {})
+{
+    return std::make_shared<VectorBinding<T>>(target,
+                                              min,
+                                              max,
+                                              std::move(default_value));
+}
+
+// Bind an option having choices to an enumeration (or integral) variable,
+// which is assigned the enumerator (or index) of the choice given, with an
+// optional default value
+template<typename T>
+    requires std::is_enum_v<T> || std::is_integral_v<T>
+std::shared_ptr<const OptionBinding> BindChoice(
+                    T &target,
+                    std::optional<std::type_identity_t<T>> default_value = {})
+{
+    return std::make_shared<ChoiceBinding<T>>(target,
+                                              std::move(default_value));
+}
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,190 @@
+/*
+ *  option_map.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the OptionMap object, which holds the key/value
+ *      pairs given for an option having the value type ValueType::Map
+ *      (e.g., "-D name=value").
+ *
+ *      The text of all keys and values is held in a single buffer and the
+ *      pairs are indexed by an open-addressing hash table (using linear
+ *      probing) of entry indices, so looking up a key requires computing one
+ *      keyed hash and comparing the key against only the few entries
+ *      probed.  Lookups do not allocate memory and return views of the
+ *      stored text, which remain valid until the map is cleared or another
+ *      pair is inserted (i.e., until options are cleared or arguments are
+ *      parsed again).
+ *
+ *      When a key is given more than once, the DuplicateKeys policy given
+ *      for the option determines whether the last value replaces earlier
+ *      values, the duplicate is an error, or all values are collected in the
+ *      order given.  Pairs are presented by ForEach() in the order in which
+ *      their keys were first given.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Terra::ProgramOptions
+{
+
+// Define how values given for the same key of a map option are handled
+enum class DuplicateKeys
+{
+    LastWins,                                   // Replace the earlier value
+    Error,                                      // Report an error
+    Collect                                     // Keep all values
+};
+
+// Define a flat hash map of keys to values given for a map option
+class OptionMap
+{
+    protected:
+        // Indicates the absence of an entry
+        static constexpr std::uint32_t No_Entry = 0xffff'ffff;
+
+    public:
+        // Define an iterator over the values given for a key
+        class ValueIterator
+        {
+            public:
+                using iterator_concept = std::forward_iterator_tag;
+                using value_type = std::string_view;
+                using difference_type = std::ptrdiff_t;
+
+                ValueIterator() = default;
+                ValueIterator(const OptionMap *map, std::uint32_t entry) :
+                    map{map},
+                    entry{entry}
+                {
+                }
+
+                std::string_view operator*() const
+                {
+                    return map->EntryValue(map->entries[entry]);
+                }
+
+                ValueIterator &operator++()
+                {
+                    entry = map->entries[entry].next;
+                    return *this;
+                }
+
+                ValueIterator operator++(int)
+                {
+                    ValueIterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                bool operator==(const ValueIterator &other) const = default;
+
+                bool operator==(std::default_sentinel_t) const
+                {
+                    return entry == No_Entry;
+                }
+
+            protected:
+                const OptionMap *map{nullptr};
+                std::uint32_t entry{No_Entry};
+        };
+        using Values = std::ranges::subrange<ValueIterator,
+                                             std::default_sentinel_t>;
+
+        OptionMap() = default;
+        ~OptionMap() = default;
+
+        bool Insert(std::string_view key,
+                    std::string_view value,
+                    DuplicateKeys duplicate_keys);
+        void Clear() noexcept;
+        void Reserve(std::size_t count);
+
+        bool Contains(std::string_view key) const noexcept;
+        std::optional<std::string_view> Find(
+                                        std::string_view key) const noexcept;
+        Values FindAll(std::string_view key) const noexcept;
+        std::size_t Count(std::string_view key) const noexcept;
+        std::size_t Size() const noexcept;
+        bool Empty() const noexcept;
+
+        // Call func(key, value) for each key, in the order keys were first
+        // given, and each of its values, in the order given
+        template<typename Func>
+        void ForEach(const Func &func) const
+        {
+            for (const auto &entry : entries)
+            {
+                if (entry.last == No_Entry) continue;
+
+                for (std::uint32_t i = FirstEntry(entry); i != No_Entry;
+                     i = entries[i].next)
+                {
+                    func(EntryKey(entry), EntryValue(entries[i]));
+                }
+            }
+        }
+
+    protected:
+        // A key/value pair, where the first entry for a key (the head) holds
+        // the index of the last entry for the key and subsequent values
+        // given for the key are linked via next
+        struct Entry
+        {
+            std::uint64_t hash;                 // Keyed hash of the key
+            std::uint32_t key_offset;           // Offset of the key in text
+            std::uint32_t key_length;           // Length of the key
+            std::uint32_t value_offset;         // Offset of the value in text
+            std::uint32_t value_length;         // Length of the value
+            std::uint32_t next;                 // Next entry for this key
+            std::uint32_t last;                 // Last entry (if the head)
+        };
+
+        static std::uint64_t HashKey(std::string_view key) noexcept;
+        std::uint32_t FindHead(std::string_view key,
+                               std::uint64_t hash) const noexcept;
+        void Grow();
+        std::uint32_t Append(std::string_view data);
+
+        std::uint32_t FirstEntry(const Entry &head) const noexcept
+        {
+            return static_cast<std::uint32_t>(&head - entries.data());
+        }
+
+        std::string_view EntryKey(const Entry &entry) const noexcept
+        {
+            return std::string_view(text).substr(entry.key_offset,
+                                                 entry.key_length);
+        }
+
+        std::string_view EntryValue(const Entry &entry) const noexcept
+        {
+            return std::string_view(text).substr(entry.value_offset,
+                                                 entry.value_length);
+        }
+
+        std::string text;                       // Text of keys and values
+        std::vector<Entry> entries;             // Entries in order given
+        std::vector<std::uint32_t> table;       // Head entry index plus one
+        std::size_t key_count{0};               // Number of distinct keys
+};
+
+} // namespace Terra::ProgramOptions
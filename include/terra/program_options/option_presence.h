@@ -0,0 +1,150 @@
+/*
+ *  option_presence.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the OptionPresence object, which is a dense bitset
+ *      having one bit per program option, indexed by the option's handle
+ *      (i.e., the index of the option within the Options given to the
+ *      Parser).  A Parser maintains the set of options given while parsing
+ *      and returns it from GetOptionPresence(), and masks of options of
+ *      interest may be obtained from GetOptionMask():
+ *
+ *          const auto debugging = parser.GetOptionMask({"debug", "trace"});
+ *
+ *          OptionPresence presence = parser.GetOptionPresence();
+ *
+ *          if (presence.Any(debugging)) ...
+ *
+ *      Testing a mask requires one word operation per 64 options, so code
+ *      may test many options at once rather than caching the result of
+ *      calling OptionGiven() for each.  Copying a set into another set of
+ *      the same size (e.g., a per-thread copy refreshed after each parse)
+ *      reuses the existing storage and does not allocate memory.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Terra::ProgramOptions
+{
+
+// Define a dense set of options, having one bit per option
+class OptionPresence
+{
+    public:
+        OptionPresence() = default;
+        explicit OptionPresence(std::size_t option_count) :
+            words((option_count + 63) / 64, 0)
+        {
+        }
+
+        // Add or remove the option having the given handle
+        void Set(std::size_t handle) noexcept
+        {
+            words[handle / 64] |= std::uint64_t(1) << (handle % 64);
+        }
+        void Reset(std::size_t handle) noexcept
+        {
+            words[handle / 64] &= ~(std::uint64_t(1) << (handle % 64));
+        }
+
+        // Remove all options, retaining the storage
+        void Clear() noexcept
+        {
+            std::fill(words.begin(), words.end(), 0);
+        }
+
+        // Is the option having the given handle in the set?
+        bool Test(std::size_t handle) const noexcept
+        {
+            return ((words[handle / 64] >> (handle % 64)) & 1) != 0;
+        }
+
+        // Are any of the options in the mask in the set?
+        bool Any(const OptionPresence &mask) const noexcept
+        {
+            const std::size_t count = std::min(words.size(), mask.words.size());
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                if ((words[i] & mask.words[i]) != 0) return true;
+            }
+
+            return false;
+        }
+
+        // Are all of the options in the mask in the set?
+        bool All(const OptionPresence &mask) const noexcept
+        {
+            for (std::size_t i = 0; i < mask.words.size(); i++)
+            {
+                const std::uint64_t word = (i < words.size()) ? words[i] : 0;
+
+                if ((word & mask.words[i]) != mask.words[i]) return false;
+            }
+
+            return true;
+        }
+
+        // Is the set empty?
+        bool Empty() const noexcept
+        {
+            return std::all_of(words.begin(),
+                               words.end(),
+                               [](std::uint64_t word) { return word == 0; });
+        }
+
+        // Return the number of options in the set
+        std::size_t Count() const noexcept
+        {
+            std::size_t count = 0;
+
+            for (const auto word : words) count += std::popcount(word);
+
+            return count;
+        }
+
+        // Return the words of the set, where bit (handle % 64) of word
+        // (handle / 64) represents the option having the given handle
+        std::span<const std::uint64_t> Words() const noexcept
+        {
+            return words;
+        }
+
+        // Call func(handle) for each option in the set, in handle order
+        template<typename Func>
+        void ForEach(const Func &func) const
+        {
+            for (std::size_t i = 0; i < words.size(); i++)
+            {
+                for (std::uint64_t word = words[i]; word != 0;
+                     word &= word - 1)
+                {
+                    func(i * 64 + std::countr_zero(word));
+                }
+            }
+        }
+
+        bool operator==(const OptionPresence &other) const = default;
+
+    protected:
+        std::vector<std::uint64_t> words;       // One bit per option
+};
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,376 @@
+/*
+ *  parse_cache.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the ParseCache object, which holds the results of
+ *      parsing recently seen argument vectors so that programs repeatedly
+ *      given the same command-lines (e.g., a launcher running scheduled jobs,
+ *      retries, or many identical tasks) parse each distinct command-line
+ *      only once.
+ *
+ *      The cache is constructed from a configured prototype parser.  Calling
+ *      ParseArguments() returns a shared, read-only parser holding the
+ *      parsed results:
+ *
+ *          Terra::ProgramOptions::ParseCache<> cache{parser};
+ *
+ *          auto result = cache.ParseArguments(arguments);
+ *          if (result->OptionGiven("verbose")) ...
+ *
+ *      Entries are keyed by a 64-bit fingerprint of the arguments seeded
+ *      with the fingerprint of the option specification (see fingerprint.h).
+ *      Since fingerprints may collide, the arguments are also retained and
+ *      compared on a hit, so a cached result is only returned for identical
+ *      arguments.  When the cache holds the maximum number of entries, the
+ *      least recently used entry is discarded.  Arguments that fail to parse
+ *      are not cached, so the exception is thrown on every call.
+ *
+ *      Results are shared by all callers given the same arguments and may be
+ *      retained after the entry is discarded, as they are reference counted.
+ *      Since the const member functions of a parser do not modify it, a
+ *      result may be used from multiple threads concurrently.  The cache is
+ *      safe to use from multiple threads; parsing on a miss is performed
+ *      without holding the cache's mutex.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "program_options.h"
+#include "fingerprint.h"
+
+namespace Terra::ProgramOptions
+{
+
+// Define a cache of results from parsing arguments with parsers of type P
+template<typename P = Parser>
+class ParseCache
+{
+    public:
+        explicit ParseCache(P prototype, std::size_t capacity = 256);
+        ParseCache(const ParseCache &) = delete;
+        ~ParseCache() = default;
+
+        ParseCache &operator=(const ParseCache &) = delete;
+
+        std::shared_ptr<const P> ParseArguments(const int argc,
+                                                const char *const argv[]);
+        template<ArgumentRange R>
+            requires std::ranges::forward_range<R>
+        std::shared_ptr<const P> ParseArguments(R &&arguments);
+
+        std::size_t Size();
+        void Clear();
+
+    protected:
+        // Cached result of parsing an argument vector
+        struct Entry
+        {
+            std::uint64_t key;                  // Fingerprint of arguments
+            std::vector<std::string> arguments; // Arguments parsed
+            std::shared_ptr<const P> result;    // Parser holding results
+        };
+        using EntryList = std::list<Entry>;
+
+        template<typename R>
+        std::uint64_t ArgumentsFingerprint(R &&arguments) const;
+        template<typename R>
+        static bool SameArguments(R &&arguments,
+                                  const std::vector<std::string> &cached);
+
+        // Parser copied to parse arguments not found in the cache
+        P prototype;
+
+        // Maximum number of entries held
+        const std::size_t capacity;
+
+        // Entries ordered from most to least recently used and an index of
+        // entries by key, protected by the mutex
+        std::mutex mutex;
+        EntryList entries;
+        std::unordered_map<std::uint64_t, typename EntryList::iterator> index;
+};
+
+/*
+ *  ParseCache::ParseCache()
+ *
+ *  Description:
+ *      Constructor for the ParseCache object.
+ *
+ *  Parameters:
+ *      prototype [in]
+ *          A configured parser that is copied to parse each argument vector
+ *          not found in the cache.  Any parsed options in the prototype are
+ *          cleared.
+ *
+ *      capacity [in]
+ *          The maximum number of results held in the cache.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+ParseCache<P>::ParseCache(P prototype, std::size_t capacity) :
+    prototype{std::move(prototype)},
+    capacity{capacity}
+{
+    // Parsers created from the prototype should have no parsed options
+    this->prototype.ClearOptions();
+}
+
+/*
+ *  ParseCache::ParseArguments()
+ *
+ *  Description:
+ *      This function will return the result of parsing the given
+ *      command-line arguments, parsing them only if not found in the cache.
+ *
+ *  Parameters:
+ *      argc [in]
+ *          Count of the number of arguments in argv.
+ *
+ *      argv [in]
+ *          An array of user-provided program arguments.  This array must
+ *          include the command name (or some string, even if empty) as the
+ *          first element.
+ *
+ *  Returns:
+ *      A shared pointer to a parser holding the parsed results.  If the
+ *      user provides invalid input, an exception will be thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+std::shared_ptr<const P> ParseCache<P>::ParseArguments(
+                                                    const int argc,
+                                                    const char *const argv[])
+{
+    return ParseArguments(std::span(argv, static_cast<std::size_t>(argc)));
+}
+
+/*
+ *  ParseCache::ParseArguments()
+ *
+ *  Description:
+ *      This function will return the result of parsing the given
+ *      command-line arguments, parsing them only if not found in the cache.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          A range of user-provided program arguments.  This range must
+ *          include the command name (or some string, even if empty) as the
+ *          first element.  The range is traversed more than once, so it must
+ *          be a forward range.
+ *
+ *  Returns:
+ *      A shared pointer to a parser holding the parsed results.  If the
+ *      user provides invalid input, an exception will be thrown.
+ *
+ *  Comments:
+ *      The returned parser is the same object for all calls with the same
+ *      arguments while the entry remains in the cache.
+ */
+template<typename P>
+template<ArgumentRange R>
+    requires std::ranges::forward_range<R>
+std::shared_ptr<const P> ParseCache<P>::ParseArguments(R &&arguments)
+{
+    const std::uint64_t key = ArgumentsFingerprint(arguments);
+
+    // Look for the arguments in the cache
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = index.find(key);
+        if ((it != index.end()) &&
+            SameArguments(arguments, it->second->arguments))
+        {
+            // Mark the entry as most recently used
+            entries.splice(entries.begin(), entries, it->second);
+
+            return it->second->result;
+        }
+    }
+
+    // Parse the arguments using a copy of the prototype
+    auto parser = std::make_shared<P>(prototype);
+    parser->ParseArguments(arguments);
+
+    Entry entry{key, {}, std::move(parser)};
+    for (const auto &argument : arguments)
+    {
+        entry.arguments.emplace_back(std::string_view(argument));
+    }
+
+    std::shared_ptr<const P> result = entry.result;
+
+    // Insert the entry, replacing any entry having the same key
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = index.find(key);
+        if (it != index.end())
+        {
+            entries.erase(it->second);
+            index.erase(it);
+        }
+
+        if (capacity == 0) return result;
+
+        // Discard the least recently used entry if the cache is full
+        if (entries.size() >= capacity)
+        {
+            index.erase(entries.back().key);
+            entries.pop_back();
+        }
+
+        entries.push_front(std::move(entry));
+        index.emplace(key, entries.begin());
+    }
+
+    return result;
+}
+
+/*
+ *  ParseCache::Size()
+ *
+ *  Description:
+ *      This function will return the number of results held in the cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of results held in the cache.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+std::size_t ParseCache<P>::Size()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return entries.size();
+}
+
+/*
+ *  ParseCache::Clear()
+ *
+ *  Description:
+ *      This function will discard all results held in the cache.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Results previously returned remain valid, as they are shared.
+ */
+template<typename P>
+void ParseCache<P>::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    index.clear();
+    entries.clear();
+}
+
+/*
+ *  ParseCache::ArgumentsFingerprint()
+ *
+ *  Description:
+ *      This function will compute the key for the given arguments, which is
+ *      the fingerprint of the arguments seeded with the fingerprint of the
+ *      prototype's option specification.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          The arguments for which to compute the key.
+ *
+ *  Returns:
+ *      The 64-bit key.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+template<typename R>
+std::uint64_t ParseCache<P>::ArgumentsFingerprint(R &&arguments) const
+{
+    Fingerprint fingerprint(prototype.GetSpecFingerprint());
+
+    for (const auto &argument : arguments)
+    {
+        fingerprint.Update(std::string_view(argument));
+    }
+
+    return fingerprint.Value();
+}
+
+/*
+ *  ParseCache::SameArguments()
+ *
+ *  Description:
+ *      This function will determine whether the given arguments are the same
+ *      as those held in a cache entry.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          The arguments to compare.
+ *
+ *      cached [in]
+ *          The arguments held in the cache entry.
+ *
+ *  Returns:
+ *      True if the arguments are the same, false if not.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+template<typename R>
+bool ParseCache<P>::SameArguments(R &&arguments,
+                                  const std::vector<std::string> &cached)
+{
+    auto it = cached.begin();
+
+    for (const auto &argument : arguments)
+    {
+        if ((it == cached.end()) || (*it != std::string_view(argument)))
+        {
+            return false;
+        }
+        ++it;
+    }
+
+    return it == cached.end();
+}
+
+} // namespace Terra::ProgramOptions
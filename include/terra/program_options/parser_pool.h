@@ -0,0 +1,339 @@
+/*
+ *  parser_pool.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the ParserPool object, which holds a set of parsers
+ *      configured identically to a prototype parser so that programs parsing
+ *      arguments at a high rate (e.g., once per request in a server) need
+ *      neither construct a parser (copying the program options) nor
+ *      serialize access to a shared parser.
+ *
+ *      A parser is checked out of the pool by calling Acquire(), which
+ *      returns a handle that returns the parser to the pool when destroyed:
+ *
+ *          Terra::ProgramOptions::ParserPool<> pool(parser);
+ *
+ *          {
+ *              auto handle = pool.Acquire();
+ *              handle->ParseArguments(arguments);
+ *              ...
+ *          }
+ *
+ *      The parser is cleared via ClearOptions() when returned, so it retains
+ *      the memory allocated for option values and parsing similar
+ *      command-lines once the pool is warm does not allocate memory.
+ *
+ *      Each thread keeps a small cache of idle parsers, so acquiring and
+ *      returning a parser on the same thread is lock-free.  Only when the
+ *      thread's cache is empty (or full, when returning) is the shared list
+ *      of idle parsers accessed while holding a mutex.  New parsers are
+ *      created by copying the prototype when no idle parser is available.
+ *
+ *      The pool is safe to use from multiple threads concurrently, though a
+ *      given handle (and the parser it refers to) must only be used by one
+ *      thread at a time.  Handles may be returned on a different thread
+ *      than the one that acquired them.  The pool must outlive all handles
+ *      acquired from it.  Parsers held in a thread's cache are released when
+ *      that thread exits or when the cache entry is reused by another pool.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "program_options.h"
+
+namespace Terra::ProgramOptions
+{
+
+// Define a pool of identically configured parsers of type P
+template<typename P = Parser>
+class ParserPool
+{
+    public:
+        // Define the handle used to access a parser acquired from the pool
+        class Handle
+        {
+            public:
+                Handle(ParserPool *pool, std::unique_ptr<P> parser) :
+                    pool{pool},
+                    parser{std::move(parser)}
+                {
+                }
+                Handle(const Handle &) = delete;
+                Handle(Handle &&other) noexcept = default;
+                ~Handle()
+                {
+                    Release();
+                }
+
+                Handle &operator=(const Handle &) = delete;
+                Handle &operator=(Handle &&other) noexcept
+                {
+                    if (this != &other)
+                    {
+                        Release();
+                        pool = other.pool;
+                        parser = std::move(other.parser);
+                    }
+                    return *this;
+                }
+
+                P &operator*() const noexcept { return *parser; }
+                P *operator->() const noexcept { return parser.get(); }
+                P *get() const noexcept { return parser.get(); }
+
+                // Return the parser to the pool before the handle is destroyed
+                void Release()
+                {
+                    if (parser) pool->Return(std::move(parser));
+                }
+
+            protected:
+                ParserPool *pool;
+                std::unique_ptr<P> parser;
+        };
+
+        explicit ParserPool(P prototype, std::size_t max_idle = 64);
+        ParserPool(const ParserPool &) = delete;
+        ~ParserPool() = default;
+
+        ParserPool &operator=(const ParserPool &) = delete;
+
+        Handle Acquire();
+
+    protected:
+        // Number of idle parsers each thread may cache for each type P
+        static constexpr std::size_t Thread_Cache_Size = 4;
+
+        // Entry in the per-thread cache of idle parsers
+        struct CacheEntry
+        {
+            std::uint64_t pool_id;
+            std::unique_ptr<P> parser;
+        };
+        using ThreadCache = std::array<CacheEntry, Thread_Cache_Size>;
+
+        static ThreadCache &GetThreadCache();
+        static std::uint64_t NextPoolId();
+        void Return(std::unique_ptr<P> parser);
+
+        // Identifier distinguishing this pool's entries in thread caches
+        const std::uint64_t pool_id;
+
+        // Parser copied to create new parsers
+        P prototype;
+
+        // Maximum number of parsers kept in the shared idle list
+        const std::size_t max_idle;
+
+        // Shared list of idle parsers, protected by the mutex
+        std::mutex mutex;
+        std::vector<std::unique_ptr<P>> idle;
+};
+
+/*
+ *  ParserPool::ParserPool()
+ *
+ *  Description:
+ *      Constructor for the ParserPool object.
+ *
+ *  Parameters:
+ *      prototype [in]
+ *          A configured parser that is copied to create each parser in the
+ *          pool.  Any parsed options in the prototype are cleared.
+ *
+ *      max_idle [in]
+ *          The maximum number of idle parsers retained in the shared list of
+ *          idle parsers (in addition to those cached by each thread).
+ *          Parsers returned when the list is full are destroyed.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+ParserPool<P>::ParserPool(P prototype, std::size_t max_idle) :
+    pool_id{NextPoolId()},
+    prototype{std::move(prototype)},
+    max_idle{max_idle}
+{
+    // Parsers created from the prototype should have no parsed options
+    this->prototype.ClearOptions();
+}
+
+/*
+ *  ParserPool::Acquire()
+ *
+ *  Description:
+ *      This function will check out a parser from the pool.  An idle parser
+ *      cached by the calling thread is used if one exists; otherwise, one is
+ *      taken from the shared list of idle parsers or, if none are idle, a new
+ *      parser is created by copying the prototype.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A handle to the parser, which is returned to the pool when the handle
+ *      is destroyed or Release() is called.
+ *
+ *  Comments:
+ *      The parser has no parsed options when acquired.
+ */
+template<typename P>
+typename ParserPool<P>::Handle ParserPool<P>::Acquire()
+{
+    // Look for an idle parser in this thread's cache
+    for (auto &entry : GetThreadCache())
+    {
+        if ((entry.pool_id == pool_id) && entry.parser)
+        {
+            return Handle(this, std::move(entry.parser));
+        }
+    }
+
+    // Look for an idle parser in the shared list
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!idle.empty())
+        {
+            std::unique_ptr<P> parser = std::move(idle.back());
+            idle.pop_back();
+            return Handle(this, std::move(parser));
+        }
+    }
+
+    // Create a new parser
+    return Handle(this, std::make_unique<P>(prototype));
+}
+
+/*
+ *  ParserPool::Return()
+ *
+ *  Description:
+ *      This function will return a parser to the pool, clearing its parsed
+ *      options.  The parser is placed into the calling thread's cache if
+ *      there is room, else into the shared list of idle parsers if there is
+ *      room, else it is destroyed.
+ *
+ *  Parameters:
+ *      parser [in]
+ *          The parser to return.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A cache entry holding a parser belonging to another pool may be
+ *      reused, in which case that parser is destroyed.
+ */
+template<typename P>
+void ParserPool<P>::Return(std::unique_ptr<P> parser)
+{
+    parser->ClearOptions();
+
+    ThreadCache &cache = GetThreadCache();
+
+    // Place the parser into an empty entry in this thread's cache
+    for (auto &entry : cache)
+    {
+        if (!entry.parser)
+        {
+            entry.pool_id = pool_id;
+            entry.parser = std::move(parser);
+            return;
+        }
+    }
+
+    // Place the parser into the shared list
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (idle.size() < max_idle)
+        {
+            idle.push_back(std::move(parser));
+            return;
+        }
+    }
+
+    // Replace an entry in this thread's cache belonging to another pool
+    for (auto &entry : cache)
+    {
+        if (entry.pool_id != pool_id)
+        {
+            entry.pool_id = pool_id;
+            entry.parser = std::move(parser);
+            return;
+        }
+    }
+}
+
+/*
+ *  ParserPool::GetThreadCache()
+ *
+ *  Description:
+ *      This function will return the calling thread's cache of idle parsers
+ *      of type P, which is shared by all pools of that type.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A reference to the calling thread's cache.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename P>
+typename ParserPool<P>::ThreadCache &ParserPool<P>::GetThreadCache()
+{
+    thread_local ThreadCache cache{};
+
+    return cache;
+}
+
+/*
+ *  ParserPool::NextPoolId()
+ *
+ *  Description:
+ *      This function will return a unique identifier for a new pool.  Since
+ *      identifiers are never reused, a pool created at the same address as a
+ *      destroyed pool will not use parsers cached for the destroyed pool.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The pool identifier.
+ *
+ *  Comments:
+ *      Identifiers start at 1, as 0 denotes an unused cache entry.
+ */
+template<typename P>
+std::uint64_t ParserPool<P>::NextPoolId()
+{
+    static std::atomic<std::uint64_t> next_pool_id{1};
+
+    return next_pool_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Terra::ProgramOptions
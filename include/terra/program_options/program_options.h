@@ -20,12 +20,16 @@
  *      library.
  *
  *      If one need to access this object from multiple threads, it should
- *      be protected to ensure serial access.
+ *      be protected to ensure serial access.  However, once arguments are
+ *      parsed, the const member functions (e.g., GetOptionCount() or
+ *      GetOptionStringsView()) may be called from multiple threads
+ *      concurrently, as they do not modify the Parser.
  *
  *      Program options may be specified using either one or two option flags
  *      followed by an option name.  An option that does not have an associated
- *      value will have an empty string stored internally to represent presence
- *      of the option.
+ *      value is only counted internally to represent presence of the option,
+ *      though it is presented as an empty string if its strings are copied
+ *      via GetOptionString() or GetOptionStrings().
  *
  *      All of the raw strings provided to the program that are not prefaced by
  *      an option flag (e.g., "-" or "/") or appears to be a raw option flag
@@ -146,11 +150,18 @@
  *      It is possible to specify that program option names are case
  *      insensitive (e.g., "--foo" is the same as "--FOO"), but option flags
  *      and option value separator characters are always case sensitive.
+ *      Case folding does not depend on the C locale.  ASCII characters are
+ *      always folded and, if any long option name contains non-ASCII
+ *      characters, common two-octet UTF-8 characters (e.g., Latin-1, Greek,
+ *      and Cyrillic letters) are folded using Unicode simple case folding.
  *
  *      Note that the set of strings passed to ParseArguments() is expected
  *      to include the command invoked as the first string.  This may be
  *      an empty string, but the parser expects position zero in the vector
- *      to align with argv[0].  It is skipped over when parsing.
+ *      to align with argv[0].  It is skipped over when parsing.  Arguments
+ *      may be given as argc/argv, as a vector of strings, or as any input
+ *      range of elements convertible to std::string_view (e.g., a
+ *      std::span<char *> or a std::views::join of several vectors).
  *
  *      One may query how many values exist for a given option by calling
  *      GetOptionCount().  This is useful for checking option presence and for
@@ -171,24 +182,161 @@
  *      to simplify processing, which is why all of these functions behave
  *      uniformly.
  *
+ *      To avoid copying option values, GetOptionStringView() and
+ *      GetOptionStringsView() return views of the stored strings.  These
+ *      views remain valid until the next call to ClearOptions(),
+ *      ParseArguments(), SetOptions(), or TakeOptionStrings(), or until the
+ *      Parser is destroyed, moved, or assigned.  TakeOptionStrings() moves the
+ *      values out of the Parser, after which the option is treated as though
+ *      it was not given.
+ *
+ *      Rather than retrieving values after parsing, an option may be bound to
+ *      a variable (or structure member) by giving the result of Bind()
+ *      (defined in option_binding.h) as the final member of the Option,
+ *      along with bounds and a default value.  Values are then converted and
+ *      stored into the variable while parsing, and no strings are retained
+ *      for the option.
+ *
+ *      Options expecting a value may instead declare a ValueType and a
+ *      ValueRange, in which case values are converted and checked once while
+ *      parsing and stored in compact typed arrays rather than as strings.
+ *      GetOptionIntegers(), GetOptionUnsignedIntegers(), GetOptionFloats(),
+ *      and GetOptionBooleans() return the stored values without conversion,
+ *      and GetOptionValue() and GetOptionValues() convert from the typed
+ *      values rather than from strings.
+ *
+ *      Values of an option having the value type ValueType::IntervalSet are
+ *      lists of unsigned values and ranges (e.g., "--cpus=0-15,32-47") that
+ *      are merged into a sorted set of disjoint intervals while parsing.
+ *      GetOptionIntervals() returns an IntervalSet, whose Contains() function
+ *      determines membership in O(log n) time.
+ *
+ *      Values of an option having the value type ValueType::Map are split at
+ *      the option's key separator (e.g., "-D name=value") and the pairs are
+ *      stored in an OptionMap, a flat hash table from which values are found
+ *      by key without allocating memory.  The option's DuplicateKeys policy
+ *      determines whether a repeated key replaces the earlier value, is an
+ *      error (OptionsError::DuplicateKey), or adds another value.
+ *      GetOptionMap() returns the OptionMap.
+ *
+ *      An option that may be given multiple times may deduplicate its values
+ *      (Deduplicate::Exact or, ignoring case, Deduplicate::CaseFolded), in
+ *      which case a keyed hash index of the values stored is kept while
+ *      parsing and a value already given is not stored again.  Case is
+ *      folded for ASCII and two-octet UTF-8 characters using simple case
+ *      folding only (e.g., "ß" and "SS" remain distinct).  Values are kept in
+ *      the order first given, while GetOptionCount() still reports every
+ *      instance.
+ *
+ *      Constraints among options (ConstraintType::Required, Exclusive, or
+ *      Requires) may be given via SetConstraints().  They are compiled into
+ *      bitmasks over option indices and checked against the bitset of
+ *      options given once ParseArguments() completes, costing a few word
+ *      operations per constraint.  A violated constraint is reported via a
+ *      ConstraintException identifying the constraint and the options.
+ *
+ *      Each option has a handle, which is its index within the Options given
+ *      (and is returned by GetOptionHandle()).  GetOptionPresence() returns
+ *      an OptionPresence (defined in option_presence.h), a dense bitset of
+ *      the options given indexed by handle, which may be tested against a
+ *      mask from GetOptionMask() using one word operation per 64 options.
+ *      GetOptionCounts() returns the number of times each option was given,
+ *      also indexed by handle.  Both remain valid until options are cleared
+ *      or arguments are parsed again.
+ *
+ *      By default, an argument consisting only of a long flag (e.g., "--") is
+ *      stored with the arguments not associated with an option.  Instead,
+ *      SetTerminators() may name arguments that end option parsing, and
+ *      SetOptionOrder(OptionOrder::OptionsFirst) ends option parsing at the
+ *      first argument not associated with an option.  The arguments that
+ *      follow are not examined or stored; GetRemainder() returns them as a
+ *      span of the caller's original arguments.
+ *
+ *      A program that passes unrecognized options through to another program
+ *      may call SetUnknownOptions() so that arguments appearing to be options
+ *      that match no option are not reported as errors.  Instead, their
+ *      positions (and optionally those of their likely values) are recorded
+ *      in order and returned by GetUnknownPositions(), so the original
+ *      arguments may be forwarded without being copied.
+ *
+ *      A program that starts child processes may rebuild a command-line from
+ *      the options given using AppendOptions(), which appends each option in
+ *      canonical form (preferring the long option) to an ArgumentVector
+ *      (defined in argument_vector.h).  An ArgumentVector holds all arguments
+ *      in one buffer and provides the null-terminated array of pointers
+ *      expected by execve() or posix_spawn(), so options may be excluded,
+ *      replaced, or added without allocating memory for each argument.
+ *
+ *      A long-running program that parses many command-lines may give the
+ *      Parser an InternTable (defined in intern_table.h) via SetInternTable().
+ *      Values of options that would be stored as strings are then stored as
+ *      InternedValue handles, so each distinct value is held once across all
+ *      options, parses, and copies of the Parser sharing the table.  The
+ *      string getters continue to work (though GetOptionStringsView() throws
+ *      OptionsError::ValueTypeMismatch, as no strings are held by the
+ *      Parser), and GetOptionInternedValues() returns the handles.
+ *
+ *      An option expecting a value may instead list the permitted values as
+ *      choices.  Choices are compiled into a perfect hash table when the
+ *      options are set, so each value is mapped to the index of the matching
+ *      choice in constant time while parsing and values not listed are
+ *      rejected with OptionsError::InvalidChoice.  GetOptionChoice() and
+ *      GetOptionChoices() return the indices (or GetOptionChoice<E>() an
+ *      enumerator of type E, if the enumerators are listed in the same
+ *      order as the choices).
+ *
+ *      An option expecting a value may be given a value delimiter (e.g.,
+ *      ','), in which case each parameter is split into a list of values
+ *      (e.g., "--ids=1,2,3") that are stored, converted, or matched against
+ *      choices as if each were given separately.  Errors identify the
+ *      position of the offending value in the list.  The option is counted
+ *      once per instance, so GetOptionCount() may be less than the number
+ *      of values.
+ *
+ *      GetFingerprint() returns a stable 64-bit fingerprint of the parsed
+ *      results (the values given for each option and the specification used
+ *      to parse them), which may be used as a cache key.  Parsers producing
+ *      the same values produce the same fingerprint, regardless of the order
+ *      in which different options were given.  A ParseCache (defined in
+ *      parse_cache.h) returns a shared result for argument vectors that were
+ *      parsed previously.
+ *
+ *      Parsing is performed in time proportional to the total length of the
+ *      arguments, regardless of the number of program options.  Long option
+ *      names are matched by walking a trie once over the argument, with each
+ *      step costing O(log k) for an alphabet of k distinct characters, and
+ *      short option characters are matched via table lookup.  Exception
+ *      messages quote at most Max_Error_Context octets of user input, so
+ *      rejecting very long arguments is no more costly than accepting them.
+ *
  *  Portability Issues:
  *      Requires C++20 or later.
  */
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 #include <limits>
 #include <type_traits>
 #include <concepts>
 #include <cstdint>
+#include "argument_vector.h"
+#include "intern_table.h"
+#include "interval_set.h"
+#include "option_map.h"
+#include "option_presence.h"
 
 namespace Terra::ProgramOptions
 {
@@ -202,6 +350,10 @@ enum class OptionsError
     DuplicateIdentifier,
     DuplicateShortOption,
     DuplicateLongOption,
+    InvalidBinding,
+    InvalidValueType,
+    InvalidConstraint,
+    UnknownOption,
 
     // Errors related to both options spec and parsing
     InvalidShortOption,
@@ -211,7 +363,15 @@ enum class OptionsError
     MultipleInstances,
     MissingOptionArgument,
     OptionNotGiven,
-    OptionValueError
+    OptionValueError,
+    ValueTypeMismatch,
+    InvalidChoice,
+    DuplicateKey,
+
+    // Errors relating to constraints among options
+    MissingRequiredOption,
+    ConflictingOptions,
+    MissingDependency
 };
 
 // Define an exception class for program options
@@ -241,6 +401,60 @@ class SpecificationException : public OptionsException
     using OptionsException::OptionsException;
 };
 
+// Define an exception for constraints among options that are not satisfied,
+// identifying the constraint and the options that violate it
+class ConstraintException : public OptionsException
+{
+    public:
+        explicit ConstraintException(const std::string &what_arg,
+                                     OptionsError options_error,
+                                     std::size_t constraint_index,
+                                     std::vector<std::string> option_names) :
+            OptionsException(what_arg, options_error),
+            constraint_index(constraint_index),
+            option_names(std::move(option_names))
+        {
+        }
+
+        const std::size_t constraint_index;
+        const std::vector<std::string> option_names;
+};
+
+// Define the interface for storing option values into a variable, defined in
+// option_binding.h
+class OptionBinding;
+
+// Define the types to which option values are converted while parsing
+enum class ValueType
+{
+    String,                                     // Stored as strings
+    Integer,                                    // Stored as std::int64_t
+    Unsigned,                                   // Stored as std::uint64_t
+    Floating,                                   // Stored as double
+    Boolean,                                    // Stored as bool
+    IntervalSet,                                // Stored as Interval ranges
+    Map                                         // Stored as an OptionMap
+};
+
+// Define whether repeated values given for an option are stored
+enum class Deduplicate
+{
+    None,                                       // Store every value
+    Exact,                                      // Store each value once
+    CaseFolded                                  // Store once, ignoring case
+};
+
+// Define the range of values permitted for an option having a numeric type
+struct ValueRange
+{
+    std::int64_t integer_min{std::numeric_limits<std::int64_t>::min()};
+    std::int64_t integer_max{std::numeric_limits<std::int64_t>::max()};
+    std::uint64_t unsigned_min{0};
+    std::uint64_t unsigned_max{std::numeric_limits<std::uint64_t>::max()};
+    double floating_min{std::numeric_limits<double>::lowest()};
+    double floating_max{std::numeric_limits<double>::max()};
+};
+
 // Define a structure containing a single program option
 struct Option
 {
@@ -249,15 +463,91 @@ struct Option
     std::string long_option;                    // Long option name
     bool multiple_allowed;                      // Multiple options allowed?
     bool parameter_expected;                    // Parameter expected?
+    std::shared_ptr<const OptionBinding> binding{};  // Variable to assign
+    ValueType value_type{ValueType::String};    // Type of value stored
+    ValueRange value_range{};                   // Range of numeric values
+    std::vector<std::string> choices{};         // Permitted values (if any)
+    char value_delimiter{'\0'};                 // Delimiter of list values
+    char key_separator{'='};                    // Separates map keys, values
+    DuplicateKeys duplicate_keys{DuplicateKeys::LastWins}; // Map key policy
+    Deduplicate deduplicate{Deduplicate::None}; // Store unique values only
 };
 
 // Define a type used to specify the set of valid options
 using Options = std::vector<Option>;
 
+// Define the types of constraints among options
+enum class ConstraintType
+{
+    Required,                                   // Every option must be given
+    Exclusive,                                  // At most one may be given
+    Requires                                    // First requires the others
+};
+
+// Define a constraint among options, which are identified by name
+struct Constraint
+{
+    ConstraintType type;                        // Type of constraint
+    std::vector<std::string> options;           // Names of the options
+};
+
+// Define a type used to specify the constraints among options
+using Constraints = std::vector<Constraint>;
+
 // Define a concept for template functions accepting numeric types
 template <typename T>
 concept NumericType = std::is_integral_v<T> || std::is_floating_point_v<T>;
 
+// Define a concept for a range of arguments that may be parsed without first
+// copying them; elements must be convertible to std::string_view and must
+// not be temporary strings that would be destroyed after conversion
+template <typename R>
+concept ArgumentRange =
+    std::ranges::input_range<R> &&
+    std::convertible_to<std::ranges::range_reference_t<R>, std::string_view> &&
+    (std::is_lvalue_reference_v<std::ranges::range_reference_t<R>> ||
+     std::is_pointer_v<std::ranges::range_reference_t<R>> ||
+     std::same_as<std::remove_cv_t<std::ranges::range_reference_t<R>>,
+                  std::string_view>);
+
+// Define the strategies for storing values while parsing arguments
+enum class ParseStrategy
+{
+    // Store values as arguments are processed
+    SinglePass,
+
+    // Count the values for each option first, then store values into
+    // exactly-sized storage (not applicable to single-pass ranges)
+    TwoPass
+};
+
+// Define whether options may follow arguments not associated with an option
+enum class OptionOrder
+{
+    // Options and other arguments may be given in any order
+    Interleaved,
+
+    // Parsing stops at the first argument not associated with an option
+    // (as specified by POSIX), which begins the remainder
+    OptionsFirst
+};
+
+// Define how arguments that appear to be options, but match no option, are
+// handled
+enum class UnknownOptions
+{
+    // Report an error (OptionsError::InvalidShortOption or InvalidLongOption)
+    Reject,
+
+    // Record the position of the argument
+    PassThrough,
+
+    // Record the position of the argument and, unless the option includes
+    // a value (e.g., "--name=value"), of the following argument if it does
+    // not appear to be an option
+    PassThroughWithValues
+};
+
 // Define the class to parse program options
 class Parser
 {
@@ -275,7 +565,8 @@ class Parser
         Parser &operator=(const Parser &parser) = default;
         Parser &operator=(Parser &&parser) = default;
 
-        void SetOptions(const Options &options,
+        virtual void SetOptions(
+                        const Options &options,
                         const std::vector<std::string> &short_flags = {"-"},
                         const std::vector<std::string> &long_flags = {"--"},
                         const std::string &option_value_separator = "=",
@@ -283,22 +574,90 @@ class Parser
 
         virtual void ClearOptions();
 
+        void SetConstraints(const Constraints &constraints);
+        void SetParseStrategy(ParseStrategy strategy);
+        void SetTerminators(const std::vector<std::string> &terminators);
+        void SetOptionOrder(OptionOrder order);
+        void SetUnknownOptions(UnknownOptions handling);
+        void SetInternTable(std::shared_ptr<InternTable> table);
+        std::shared_ptr<InternTable> GetInternTable() const;
+        void Reserve(const std::string &option_name, std::size_t count);
+
         void ParseArguments(const int argc, const char *const argv[]);
         void ParseArguments(const std::vector<std::string> &arguments);
         void ParseArguments(const std::vector<std::string_view> &arguments);
+        template<ArgumentRange R>
+        void ParseArguments(R &&arguments);
 
-        bool OptionGiven(const std::string &option_name);
-        std::size_t GetOptionCount(const std::string &option_name);
+        bool OptionGiven(const std::string &option_name) const;
+        std::size_t GetOptionCount(const std::string &option_name) const;
 
-        std::string GetOptionString(const std::string &option_name);
+        std::size_t GetOptionHandle(const std::string &option_name) const;
+        OptionPresence GetOptionMask(
+                            const std::vector<std::string> &option_names) const;
+        const OptionPresence &GetOptionPresence() const;
+        std::span<const std::size_t> GetOptionCounts() const;
+
+        std::string GetOptionString(const std::string &option_name) const;
         std::vector<std::string> GetOptionStrings(
-                                            const std::string &option_name);
+                                        const std::string &option_name) const;
+
+        std::string_view GetOptionStringView(
+                                        const std::string &option_name) const;
+        std::span<const std::string> GetOptionStringsView(
+                                        const std::string &option_name) const;
+        std::vector<std::string> TakeOptionStrings(
+                                        const std::string &option_name);
+
+        std::pair<std::size_t, std::size_t> GetOptionPositions(
+                                        const std::string &option_name) const;
+
+        std::optional<std::size_t> GetRemainderPosition() const;
+        std::span<const std::size_t> GetUnknownPositions() const;
+        template<typename T, std::size_t Extent>
+        std::span<T> GetRemainder(std::span<T, Extent> arguments) const
+        {
+            if ((remainder_position == 0) ||
+                (remainder_position > arguments.size()))
+            {
+                return {};
+            }
+            return arguments.subspan(remainder_position);
+        }
+
+        void AppendOptions(ArgumentVector &arguments,
+                           const OptionPresence &excluded = {}) const;
+
+        std::span<const std::int64_t> GetOptionIntegers(
+                                        const std::string &option_name) const;
+        std::span<const std::uint64_t> GetOptionUnsignedIntegers(
+                                        const std::string &option_name) const;
+        std::span<const double> GetOptionFloats(
+                                        const std::string &option_name) const;
+        const std::vector<bool> &GetOptionBooleans(
+                                        const std::string &option_name) const;
+        IntervalSet GetOptionIntervals(const std::string &option_name) const;
+        const OptionMap &GetOptionMap(const std::string &option_name) const;
+        std::span<const InternedValue> GetOptionInternedValues(
+                                        const std::string &option_name) const;
+        std::span<const std::uint32_t> GetOptionChoices(
+                                        const std::string &option_name) const;
+        std::size_t GetOptionChoice(const std::string &option_name) const;
+        template<typename E>
+            requires std::is_enum_v<E>
+        E GetOptionChoice(const std::string &option_name) const
+        {
+            return static_cast<E>(GetOptionChoice(option_name));
+        }
+
+        std::uint64_t GetSpecFingerprint() const;
+        std::uint64_t GetFingerprint() const;
 
         template<NumericType T>
         void GetOptionValue(const std::string &option_name,
                             T &option_value,
-                            T min = std::numeric_limits<T>::min(),
-                            T max = std::numeric_limits<T>::max())
+                            T min = std::numeric_limits<T>::lowest(),
+                            T max = std::numeric_limits<T>::max()) const
         {
             std::vector<T> option_values;
             GetOptionValues(option_name, option_values, min, max);
@@ -307,39 +666,156 @@ class Parser
         template<NumericType T>
         void GetOptionValues(const std::string &option_name,
                              std::vector<T> &option_values,
-                             T min = std::numeric_limits<T>::min(),
-                             T max = std::numeric_limits<T>::max());
+                             T min = std::numeric_limits<T>::lowest(),
+                             T max = std::numeric_limits<T>::max()) const;
 
     protected:
-        const std::vector<std::string> &FindOptionStrings(
-                                            const std::string &option_name);
+        // Storage for values converted according to the option's ValueType
+        using TypedValues = std::variant<std::monostate,
+                                         std::vector<std::int64_t>,
+                                         std::vector<std::uint64_t>,
+                                         std::vector<double>,
+                                         std::vector<bool>,
+                                         std::vector<std::uint32_t>,
+                                         std::vector<Interval>,
+                                         OptionMap,
+                                         std::vector<InternedValue>>;
+
+        // Entry in the hash index of unique values stored for an option
+        struct IndexedValue
+        {
+            std::uint64_t hash;                 // Keyed hash of the value
+            std::uint32_t position;             // Value position plus one
+        };
+
+        // Storage for the instances of an option given on the command-line
+        struct OptionSlot
+        {
+            std::uint64_t epoch;                // Parse epoch of last use
+            std::size_t count;                  // Number of instances
+            std::size_t first_position;         // Position of first instance
+            std::size_t last_position;          // Position of last instance
+            std::size_t pending;                // Instances counted, not stored
+            std::vector<std::string> values;    // Values given (if strings)
+            TypedValues typed_values;           // Values given (if typed)
+            std::vector<IndexedValue> value_index; // Index of unique values
+        };
+
+        template<typename R>
+        void ParseArgumentRange(R &&arguments);
+        void ReservePending();
+        void DiscardPending();
+        void PrepareBindings();
+        void ApplyBindings();
+        void StoreConvertedValue(std::size_t option_index,
+                                 OptionSlot &slot,
+                                 const std::string_view value);
+        void StoreTypedValue(const Option &option,
+                             OptionSlot &slot,
+                             const std::string_view value);
+        void StoreListValues(std::size_t option_index,
+                             OptionSlot &slot,
+                             const std::string_view parameter);
+        void StoreIntervals(const Option &option,
+                            OptionSlot &slot,
+                            const std::string_view value);
+        void StoreMapEntry(const Option &option,
+                           OptionSlot &slot,
+                           const std::string_view value);
+        void StoreString(std::size_t option_index,
+                         OptionSlot &slot,
+                         const std::string_view value);
+        void StoreChoice(std::size_t option_index,
+                         OptionSlot &slot,
+                         std::uint32_t choice);
+        template<typename Equal>
+        bool InsertUniqueValue(OptionSlot &slot,
+                               std::uint64_t hash,
+                               std::size_t position,
+                               const Equal &equal);
+        bool StoresStrings(std::size_t slot_index) const;
+        bool InternsValues(std::size_t slot_index) const;
+        std::uint32_t MatchChoice(std::size_t option_index,
+                                  const std::string_view value);
+        void BuildChoiceTable(std::size_t option_index);
+        template<typename T>
+        const std::vector<T> &FindTypedValues(
+                                        const std::string &option_name) const;
+        OptionSlot &UseOptionSlot(std::size_t slot_index);
+        std::size_t SlotCount(const OptionSlot &slot) const;
+        const OptionSlot &FindOptionSlot(const std::string &option_name) const;
+        std::size_t FindStringSlot(const std::string &option_name) const;
+        std::span<const std::string> FindOptionStrings(
+                                        const std::string &option_name) const;
         template<NumericType T, typename Func>
         void GetOptionValues(const std::string &option_name,
                              const Func &converter,
                              std::vector<T> &option_values,
                              T min,
-                             T max);
+                             T max) const;
         void CheckOptionFlags();
         void CheckOptions();
-        bool ProcessArgument(const std::string_view argument,
-                             const std::optional<std::string_view> &parameter);
-        std::pair<bool, bool> ProcessLongOption(
+        void CheckConstraints() const;
+        [[noreturn]] void ThrowConstraintViolation(
+                                        std::size_t constraint_index) const;
+        virtual bool ProcessArgument(
+                            const std::string_view argument,
+                            const std::optional<std::string_view> &parameter);
+        template<typename Policy>
+        bool MatchArgument(const Policy &policy,
+                           const std::string_view argument,
+                           const std::optional<std::string_view> &parameter);
+        template<typename Policy>
+        std::pair<bool, bool> MatchLongOption(
+                            const Policy &policy,
                             const std::string_view argument,
                             const std::optional<std::string_view> &parameter);
-        std::pair<bool, bool> ProcessShortOption(
+        template<typename Policy>
+        std::pair<bool, bool> MatchShortOption(
+                            const Policy &policy,
                             const std::string_view argument,
                             const std::optional<std::string_view> &parameter);
-        bool StoreOption(const Option &option,
+        bool StoreOption(std::size_t option_index,
                          const std::optional<std::string_view> &parameter);
-        static bool FindOptionStart(
-                const std::vector<std::string> &flags,
-                std::string_view::const_iterator &argument_start_iterator,
-                const std::string_view::const_iterator &argument_end_iterator);
-        static bool FindStringStart(
-                        const std::string &prefix,
-                        std::string_view::const_iterator &start_iterator,
-                        const std::string_view::const_iterator &end_iterator);
-        static std::string Uppercase(std::string some_string);
+        void StoreOptionValue(std::size_t option_index,
+                              const std::string_view argument,
+                              const std::string_view value);
+        void StoreArgument(const std::string_view argument);
+        bool StoreUnknownOption(bool value_allowed);
+        template<typename Policy>
+        bool AppearsToBeOption(const Policy &policy,
+                               const std::string_view argument) const;
+        bool AppendOptionName(ArgumentVector &arguments,
+                              const Option &option) const;
+        template<typename Flags>
+        static bool FindOptionStart(const Flags &flags,
+                                    const std::string_view argument,
+                                    std::size_t &offset);
+        [[noreturn]] static void ThrowInvalidOption(
+                                            const std::string_view argument,
+                                            OptionsError options_error);
+        static std::string ErrorContext(std::string_view input);
+        void BuildOptionIndex();
+        void UpdateSpecFingerprint();
+        std::uint32_t FindLongOptionNode(std::uint32_t node, char c) const;
+
+        // Value indicating no option is associated with a short option
+        static constexpr std::size_t No_Option_Index =
+                                        std::numeric_limits<std::size_t>::max();
+
+        // Value indicating a node does not exist in the long option trie
+        static constexpr std::uint32_t No_Node_Index =
+                                    std::numeric_limits<std::uint32_t>::max();
+
+        // Maximum length of user input quoted in exception messages
+        static constexpr std::size_t Max_Error_Context = 256;
+
+        // Average number of choices in each bucket of a choice table
+        static constexpr std::size_t Choices_Per_Bucket = 4;
+
+        // Displacements tried for a bucket of a choice table before the
+        // table is built again using another fingerprint seed
+        static constexpr std::uint32_t Displacement_Limit = 65'536;
 
         // Program options
         Options options;
@@ -356,12 +832,291 @@ class Parser
         // Options case insensitive?
         bool case_insensitive;
 
-        // A map to hold the parsed program options
-        // NOTE: The key "" (i.e., empty string) is used to hold all strings
-        //       provided on the command-line  that are not associated with a
-        //       named option (e.g., list of files or other non-option
-        //       arguments on the command-line)
-        std::unordered_map<std::string, std::vector<std::string>> option_map;
+        // Node within the trie of long option names; the children of a node
+        // are the edges [first_edge, first_edge + edge_count), sorted by label
+        struct LongOptionNode
+        {
+            std::size_t option_index;           // Option name ending here
+            std::uint32_t first_edge;           // Index of the first edge
+            std::uint32_t edge_count;           // Number of edges
+        };
+
+        // Trie of long option names (case-folded if options are case
+        // insensitive), allowing a name to be matched in time proportional to
+        // the length of the argument regardless of the number of options
+        std::vector<LongOptionNode> long_option_nodes;
+        std::vector<char> long_option_edge_labels;
+        std::vector<std::uint32_t> long_option_edge_targets;
+
+        // Table mapping a short option character to an index into options
+        std::array<std::size_t, 256> short_option_index;
+
+        // Should non-ASCII characters be folded when matching?
+        bool unicode_folding;
+
+        // Buffer used to hold a case-folded argument while matching
+        std::string folded_argument;
+
+        // Buffer used to hold an argument read from a single-pass range while
+        // the following argument is examined
+        std::string buffered_argument;
+
+        // Map of option names to an index into option_slots
+        // NOTE: The name "" (i.e., empty string) refers to the final slot,
+        //       which holds all strings provided on the command-line that are
+        //       not associated with a named option (e.g., list of files or
+        //       other non-option arguments on the command-line)
+        std::unordered_map<std::string, std::size_t> option_slot_index;
+
+        // Parsed program options, one slot per option plus the final slot
+        // holding non-option arguments; options that do not expect a value are
+        // only counted, so no strings are stored for them
+        std::vector<OptionSlot> option_slots;
+
+        // Parse epoch, advanced by ClearOptions(); slots last used in an
+        // earlier epoch are treated as empty
+        std::uint64_t epoch;
+
+        // Bitset having one bit per option, set if the option was given, and
+        // the number of times each option was given
+        OptionPresence presence;
+        std::vector<std::size_t> option_counts;
+
+        // Indices of the options given, so they may be cleared without
+        // visiting every option
+        std::vector<std::size_t> given_options;
+
+        // Constraint among options compiled to a mask over option indices,
+        // held in constraint_masks as one word per 64 options
+        struct CompiledConstraint
+        {
+            ConstraintType type;                // Exclusive or Requires
+            std::size_t constraint_index;       // Index within constraints
+            std::size_t trigger;                // Option requiring others
+            std::size_t mask_offset;            // Offset of the mask
+        };
+
+        // Constraints among options, as given and as compiled; all Required
+        // constraints are merged into required_mask
+        Constraints constraints;
+        std::vector<CompiledConstraint> compiled_constraints;
+        std::vector<std::uint64_t> constraint_masks;
+        OptionPresence required_mask;
+
+        // Position of the argument currently being processed
+        std::size_t argument_position;
+
+        // Strategy used to store values while parsing
+        ParseStrategy parse_strategy;
+
+        // Are instances only being counted (first pass of TwoPass strategy)?
+        bool counting_pass;
+
+        // Arguments that end option parsing (e.g., "--"), which are not
+        // themselves stored
+        std::vector<std::string> terminators;
+
+        // Order in which options and other arguments may be given
+        OptionOrder option_order;
+
+        // Position of the first argument not parsed (or zero if all
+        // arguments were parsed)
+        std::size_t remainder_position;
+
+        // Handling of arguments that match no option and the positions of
+        // those passed through (along with any values taken)
+        UnknownOptions unknown_options;
+        std::vector<std::size_t> unknown_positions;
+
+        // Fingerprint of the options, flags, separator, and case sensitivity
+        std::uint64_t spec_fingerprint;
+
+        // Indices of options bound to a variable
+        std::vector<std::size_t> bound_options;
+
+        // Perfect hash table mapping the choices of an option to their index;
+        // a value's fingerprint (seeded with seed) selects a bucket, whose
+        // displacement then selects the entry, which holds the index of the
+        // choice plus one (or zero)
+        struct ChoiceTable
+        {
+            std::uint64_t seed;                 // Fingerprint seed
+            std::uint64_t mask;                 // Mask selecting the entry
+            std::uint64_t bucket_mask;          // Mask selecting the bucket
+            bool unicode_folding;               // Fold non-ASCII values
+            std::vector<std::uint32_t> displacements; // Per bucket
+            std::vector<std::uint32_t> entries; // Choice index plus one
+            std::vector<std::string> names;     // Choices (case-folded)
+        };
+
+        // Choice tables for each option (empty for options without choices)
+        std::vector<ChoiceTable> choice_tables;
+
+        // Buffer used to hold a case-folded value while matching choices
+        std::string folded_choice;
+
+        // Buffers used to hold case-folded values while deduplicating
+        std::string folded_value;
+        std::string folded_stored;
+
+        // Table holding the values of options that store strings (if any)
+        std::shared_ptr<InternTable> intern_table;
 };
 
+/*
+ *  Parser::ParseArguments()
+ *
+ *  Description:
+ *      This function will parse command-line arguments given as any input
+ *      range of string-like elements (e.g., std::span<char *>, a list of
+ *      std::string objects, or a std::views::join over several vectors of
+ *      arguments).  Arguments are read directly from the range, each element
+ *      being converted to a std::string_view only when it is reached, so no
+ *      intermediate container is constructed.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          A range of user-provided program arguments.  This range must
+ *          include the command name (or some string, even if empty) as the
+ *          first element to parallel the argv[] array.  The first element
+ *          is skipped over when parsing.
+ *
+ *  Returns:
+ *      Nothing, but if the user provides invalid input an exception will be
+ *      thrown.
+ *
+ *  Comments:
+ *      If the parse strategy is ParseStrategy::TwoPass and the range may be
+ *      traversed more than once, the arguments are first processed only to
+ *      count the instances of each option so that storage for values may be
+ *      reserved once before the values are stored in a second pass.  Values
+ *      of options bound to a variable are converted and stored into the
+ *      variable as they are parsed; once parsing completes, bound options
+ *      that were not given are assigned their default value.  Constraints
+ *      among options are checked once parsing completes.
+ */
+template<ArgumentRange R>
+void Parser::ParseArguments(R &&arguments)
+{
+    if constexpr (std::ranges::forward_range<R>)
+    {
+        if (parse_strategy == ParseStrategy::TwoPass)
+        {
+            // Count the instances of each option
+            counting_pass = true;
+            try
+            {
+                ParseArgumentRange(arguments);
+            }
+            catch (...)
+            {
+                counting_pass = false;
+                DiscardPending();
+                throw;
+            }
+            counting_pass = false;
+
+            // Reserve storage for the values counted
+            ReservePending();
+        }
+    }
+
+    // Store values directly into any bound variables
+    if (bound_options.empty())
+    {
+        ParseArgumentRange(arguments);
+    }
+    else
+    {
+        PrepareBindings();
+        ParseArgumentRange(arguments);
+        ApplyBindings();
+    }
+
+    // Check constraints among the options given
+    if (!constraints.empty()) CheckConstraints();
+}
+
+/*
+ *  Parser::ParseArgumentRange()
+ *
+ *  Description:
+ *      This function will process each of the arguments in the given range.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          A range of user-provided program arguments, the first of which is
+ *          skipped over.
+ *
+ *  Returns:
+ *      Nothing, but if the user provides invalid input an exception will be
+ *      thrown.
+ *
+ *  Comments:
+ *      Since an option may consume the argument that follows it, each
+ *      argument is examined along with the next one.  For single-pass ranges
+ *      (e.g., std::views::istream), advancing the iterator may invalidate
+ *      the previous element, so the current argument is copied into a buffer
+ *      that is reused across calls.  Arguments following a terminator (or,
+ *      if options must come first, the first argument not associated with
+ *      an option) are not examined.
+ */
+template<typename R>
+void Parser::ParseArgumentRange(R &&arguments)
+{
+    auto it = std::ranges::begin(arguments);
+    const auto end = std::ranges::end(arguments);
+
+    remainder_position = 0;
+
+    // Skip over the command name
+    if (it == end) return;
+    if (++it == end) return;
+
+    std::string_view argument = *it;
+    argument_position = 1;
+
+    while (true)
+    {
+        // Single-pass ranges may not retain the current element once the
+        // iterator is advanced
+        if constexpr (!std::ranges::forward_range<R>)
+        {
+            buffered_argument.assign(argument);
+            argument = buffered_argument;
+        }
+
+        // A terminator ends parsing, leaving the following arguments as the
+        // remainder
+        if (!terminators.empty() &&
+            (std::ranges::find(terminators, argument) != terminators.end()))
+        {
+            remainder_position = argument_position + 1;
+            break;
+        }
+
+        // Is there a parameter to pass?
+        std::optional<std::string_view> parameter;
+        if (++it != end) parameter = *it;
+
+        // Process the current argument, returning true if the next argument
+        // (labeled parameter here) was also consumed
+        if (ProcessArgument(argument, parameter))
+        {
+            if (++it == end) break;
+            argument = *it;
+            argument_position += 2;
+        }
+        else
+        {
+            // Stop if the argument began the remainder
+            if (remainder_position != 0) break;
+
+            if (!parameter) break;
+            argument = *parameter;
+            argument_position++;
+        }
+    }
+}
+
 } // namespace Terra::ProgramOptions
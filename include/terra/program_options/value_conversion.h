@@ -0,0 +1,138 @@
+/*
+ *  value_conversion.h
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file defines the functions used to convert option value strings
+ *      to numeric and boolean values while arguments are parsed.
+ *
+ *      Numbers are converted using std::from_chars, so conversion does not
+ *      depend on the C locale, does not allocate memory, and requires the
+ *      entire string to be consumed (e.g., "12abc" is rejected).  Leading
+ *      white space and '+' signs are not accepted.  Boolean values may be
+ *      given as "true", "false", "yes", "no", "on", "off", "1", or "0" (in
+ *      any case).
+ *
+ *      Errors are reported by throwing std::invalid_argument if the string
+ *      is not a valid value or std::out_of_range if the value is not within
+ *      the given bounds, in which case the exception describes the valid
+ *      range.  The Parser translates these into an OptionsException that
+ *      identifies the option.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include "case_fold.h"
+#include "program_options.h"
+
+namespace Terra::ProgramOptions
+{
+
+// Throw an exception indicating a value is outside the range [min, max]
+template<NumericType T>
+[[noreturn]] void ThrowRangeError(T min, T max)
+{
+    std::ostringstream oss;
+
+    // Promote character types so they are shown as numbers
+    oss << "valid range is " << +min << " .. " << +max;
+
+    throw std::out_of_range(oss.str());
+}
+
+// Convert a string to a boolean value
+inline bool ConvertBoolean(std::string_view value)
+{
+    constexpr std::array<std::string_view, 4> true_values{"true", "yes", "on",
+                                                          "1"};
+    constexpr std::array<std::string_view, 4> false_values{"false", "no",
+                                                           "off", "0"};
+
+    // Compare the value case insensitively against each of the given words
+    auto matches = [value](const auto &words)
+    {
+        for (const auto word : words)
+        {
+            if (word.size() != value.size()) continue;
+
+            std::size_t i = 0;
+            while ((i < word.size()) && (FoldASCII(value[i]) == word[i])) i++;
+
+            if (i == word.size()) return true;
+        }
+
+        return false;
+    };
+
+    if (matches(true_values)) return true;
+    if (matches(false_values)) return false;
+
+    throw std::invalid_argument("invalid boolean value");
+}
+
+// Convert a string to a value of type T in the range [min, max]
+template<NumericType T>
+T ConvertValue(std::string_view value, T min, T max)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        bool result = ConvertBoolean(value);
+
+        if ((result < min) || (result > max)) ThrowRangeError(min, max);
+
+        return result;
+    }
+    else
+    {
+        T result{};
+        const char *end = value.data() + value.size();
+        std::from_chars_result conversion{};
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            conversion = std::from_chars(value.data(), end, result);
+
+            // Reject values that are not numbers, as they cannot be compared
+            if ((conversion.ec == std::errc()) && (result != result))
+            {
+                conversion.ec = std::errc::invalid_argument;
+            }
+        }
+        else
+        {
+            conversion = std::from_chars(value.data(), end, result, 10);
+        }
+
+        if (conversion.ec == std::errc::result_out_of_range)
+        {
+            ThrowRangeError(min, max);
+        }
+        if ((conversion.ec != std::errc()) || (conversion.ptr != end) ||
+            value.empty())
+        {
+            throw std::invalid_argument("invalid numeric value");
+        }
+        if ((result < min) || (result > max)) ThrowRangeError(min, max);
+
+        return result;
+    }
+}
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,250 @@
+/*
+ *  argument_vector.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the ArgumentVector object, which builds a
+ *      command-line for a child process in a single contiguous buffer.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <algorithm>
+#include <terra/program_options/argument_vector.h>
+
+namespace Terra::ProgramOptions
+{
+
+/*
+ *  ArgumentVector::Clear()
+ *
+ *  Description:
+ *      This function will remove all arguments.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The storage is retained so that building another command-line of
+ *      similar length does not allocate memory.
+ */
+void ArgumentVector::Clear() noexcept
+{
+    buffer.clear();
+    offsets.clear();
+}
+
+/*
+ *  ArgumentVector::Reserve()
+ *
+ *  Description:
+ *      This function will reserve storage for the given number of arguments
+ *      and characters.
+ *
+ *  Parameters:
+ *      argument_count [in]
+ *          The number of arguments expected.
+ *
+ *      character_count [in]
+ *          The total length of the arguments expected, excluding the
+ *          terminating null characters.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ArgumentVector::Reserve(std::size_t argument_count,
+                             std::size_t character_count)
+{
+    buffer.reserve(character_count + argument_count);
+    offsets.reserve(argument_count);
+    pointers.reserve(argument_count + 1);
+}
+
+/*
+ *  ArgumentVector::Append()
+ *
+ *  Description:
+ *      This function will append an argument.
+ *
+ *  Parameters:
+ *      argument [in]
+ *          The argument to append, which is copied.  It may refer to an
+ *          argument already held (e.g., arguments[0]).
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Pointers previously returned by Data() may be invalidated.  An
+ *      argument containing a null character is truncated at that character
+ *      when given to a child process.
+ */
+void ArgumentVector::Append(std::string_view argument)
+{
+    Append({argument});
+}
+
+/*
+ *  ArgumentVector::Append()
+ *
+ *  Description:
+ *      This function will append a single argument formed by concatenating
+ *      the given parts (e.g., {"--name", "=", "value"}), so that the
+ *      argument is not assembled in a temporary string first.
+ *
+ *  Parameters:
+ *      parts [in]
+ *          The parts of the argument to append, which are copied.  They may
+ *          refer to arguments already held.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Pointers previously returned by Data() may be invalidated.  An
+ *      argument containing a null character is truncated at that character
+ *      when given to a child process.
+ */
+void ArgumentVector::Append(std::initializer_list<std::string_view> parts)
+{
+    const std::size_t offset = buffer.size();
+
+    AppendCharacters(parts);
+    offsets.push_back(offset);
+}
+
+/*
+ *  ArgumentVector::Extend()
+ *
+ *  Description:
+ *      This function will append the given characters to the last argument,
+ *      which allows an argument having a variable number of parts (e.g., a
+ *      list of values) to be formed in place.
+ *
+ *  Parameters:
+ *      part [in]
+ *          The characters to append, which are copied.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If there are no arguments, a new argument is appended.
+ */
+void ArgumentVector::Extend(std::string_view part)
+{
+    if (offsets.empty())
+    {
+        Append(part);
+        return;
+    }
+
+    // Replace the terminating null character, which does not move the
+    // buffer, so the part may still refer to the last argument
+    buffer.pop_back();
+    AppendCharacters({part});
+}
+
+/*
+ *  ArgumentVector::AppendCharacters()
+ *
+ *  Description:
+ *      This function will append the given parts to the buffer, followed by
+ *      a terminating null character.
+ *
+ *  Parameters:
+ *      parts [in]
+ *          The parts to append, which may refer to characters in the buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The total length is determined first, so the buffer grows at most
+ *      once.  If it must grow, the characters are copied into new storage
+ *      before the existing storage is released, so parts referring to the
+ *      buffer remain valid while they are copied.
+ */
+void ArgumentVector::AppendCharacters(
+                                std::initializer_list<std::string_view> parts)
+{
+    std::size_t length = 1;
+
+    for (const auto part : parts) length += part.size();
+
+    const std::size_t size = buffer.size();
+    const bool must_grow = (size + length > buffer.capacity());
+    std::vector<char> grown;
+
+    // Grow geometrically into new storage, retaining the existing storage
+    // until the parts are copied
+    if (must_grow)
+    {
+        grown.reserve(std::max(size + length, buffer.capacity() * 2));
+        grown.assign(buffer.begin(), buffer.end());
+        grown.resize(size + length);
+    }
+    else
+    {
+        buffer.resize(size + length);
+    }
+
+    char *position = (must_grow ? grown.data() : buffer.data()) + size;
+    for (const auto part : parts)
+    {
+        position = std::copy(part.begin(), part.end(), position);
+    }
+    *position = '\0';
+
+    if (must_grow) buffer.swap(grown);
+}
+
+/*
+ *  ArgumentVector::Data()
+ *
+ *  Description:
+ *      This function will return the arguments as an array of pointers to
+ *      null-terminated strings, followed by a null pointer, as expected by
+ *      execve() and posix_spawn().
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The array of pointers, which remains valid until the object is
+ *      modified or destroyed.
+ *
+ *  Comments:
+ *      The pointers are assigned on each call, since appending an argument
+ *      or copying the object moves the buffer.  The array is reused, so
+ *      this does not allocate memory once it has grown to the number of
+ *      arguments.
+ */
+char *const *ArgumentVector::Data()
+{
+    pointers.clear();
+
+    for (const auto offset : offsets)
+    {
+        pointers.push_back(buffer.data() + offset);
+    }
+
+    pointers.push_back(nullptr);
+
+    return pointers.data();
+}
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,212 @@
+/*
+ *  case_fold.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the case folding functions used to match program
+ *      options case insensitively.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <cstdint>
+#include <terra/program_options/case_fold.h>
+
+namespace Terra::ProgramOptions
+{
+
+namespace
+{
+
+/*
+ *  FoldCodePoint()
+ *
+ *  Description:
+ *      This function will apply Unicode simple case folding to the given
+ *      code point, which must be in the range U+0080 .. U+07FF (i.e., a code
+ *      point encoded in UTF-8 using two octets).  Only those mappings that
+ *      produce a code point in the same range are applied.
+ *
+ *  Parameters:
+ *      code_point [in]
+ *          The code point to fold.
+ *
+ *  Returns:
+ *      The folded code point, or the original code point if there is no
+ *      applicable mapping.
+ *
+ *  Comments:
+ *      None.
+ */
+constexpr std::uint32_t FoldCodePoint(std::uint32_t code_point) noexcept
+{
+    // Latin-1 Supplement (except multiplication sign)
+    if ((code_point >= 0x00C0) && (code_point <= 0x00DE))
+    {
+        return (code_point == 0x00D7) ? code_point : code_point + 0x20;
+    }
+
+    // Micro sign folds to Greek small letter mu
+    if (code_point == 0x00B5) return 0x03BC;
+
+    // Latin Extended-A (alternating upper / lower pairs)
+    if (((code_point >= 0x0100) && (code_point <= 0x012F)) ||
+        ((code_point >= 0x0132) && (code_point <= 0x0137)) ||
+        ((code_point >= 0x014A) && (code_point <= 0x0177)))
+    {
+        return code_point | 0x0001;
+    }
+    if (((code_point >= 0x0139) && (code_point <= 0x0148)) ||
+        ((code_point >= 0x0179) && (code_point <= 0x017E)))
+    {
+        return (code_point & 0x0001) ? code_point + 1 : code_point;
+    }
+    if (code_point == 0x0178) return 0x00FF;
+
+    // Greek
+    if (code_point == 0x0386) return 0x03AC;
+    if ((code_point >= 0x0388) && (code_point <= 0x038A))
+    {
+        return code_point + 0x25;
+    }
+    if (code_point == 0x038C) return 0x03CC;
+    if ((code_point >= 0x038E) && (code_point <= 0x038F))
+    {
+        return code_point + 0x3F;
+    }
+    if ((code_point >= 0x0391) && (code_point <= 0x03AB))
+    {
+        return (code_point == 0x03A2) ? code_point : code_point + 0x20;
+    }
+    if (code_point == 0x03C2) return 0x03C3;
+
+    // Cyrillic
+    if ((code_point >= 0x0400) && (code_point <= 0x040F))
+    {
+        return code_point + 0x50;
+    }
+    if ((code_point >= 0x0410) && (code_point <= 0x042F))
+    {
+        return code_point + 0x20;
+    }
+    if (((code_point >= 0x0460) && (code_point <= 0x0481)) ||
+        ((code_point >= 0x048A) && (code_point <= 0x04BF)) ||
+        ((code_point >= 0x04D0) && (code_point <= 0x052F)))
+    {
+        return code_point | 0x0001;
+    }
+    if (code_point == 0x04C0) return 0x04CF;
+    if ((code_point >= 0x04C1) && (code_point <= 0x04CE))
+    {
+        return (code_point & 0x0001) ? code_point + 1 : code_point;
+    }
+
+    // Armenian
+    if ((code_point >= 0x0531) && (code_point <= 0x0556))
+    {
+        return code_point + 0x30;
+    }
+
+    return code_point;
+}
+
+} // namespace
+
+/*
+ *  FoldCase()
+ *
+ *  Description:
+ *      This function will fold the case of the input string, placing the
+ *      result into the output string.  ASCII characters are always folded.
+ *      If unicode is true, two-octet UTF-8 sequences are also folded using
+ *      Unicode simple case folding.  The output string is always the same
+ *      length as the input string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The string to fold.
+ *
+ *      output [out]
+ *          The string into which the folded result is placed.  Existing
+ *          capacity is reused, so no memory is allocated if the output string
+ *          is already large enough.
+ *
+ *      unicode [in]
+ *          Indicates whether non-ASCII characters should be folded.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Invalid UTF-8 sequences are copied unchanged.
+ */
+void FoldCase(std::string_view input, std::string &output, bool unicode)
+{
+    output.resize(input.length());
+
+    for (std::size_t i = 0; i < input.length(); i++)
+    {
+        const auto octet = static_cast<unsigned char>(input[i]);
+
+        // Handle the ASCII fast path
+        if (!(octet & 0x80) || !unicode)
+        {
+            output[i] = FoldASCII(input[i]);
+            continue;
+        }
+
+        // Only two-octet sequences are folded; copy anything else as-is
+        if (((octet & 0xE0) != 0xC0) || ((i + 1) >= input.length()) ||
+            ((static_cast<unsigned char>(input[i + 1]) & 0xC0) != 0x80))
+        {
+            output[i] = input[i];
+            continue;
+        }
+
+        // Decode, fold, and re-encode the code point
+        std::uint32_t code_point =
+            (static_cast<std::uint32_t>(octet & 0x1F) << 6) |
+            (static_cast<std::uint32_t>(input[i + 1]) & 0x3F);
+        code_point = FoldCodePoint(code_point);
+        output[i] = static_cast<char>(0xC0 | (code_point >> 6));
+        output[i + 1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        i++;
+    }
+}
+
+/*
+ *  FoldCase()
+ *
+ *  Description:
+ *      This function will return a case-folded copy of the input string.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The string to fold.
+ *
+ *      unicode [in]
+ *          Indicates whether non-ASCII characters should be folded.
+ *
+ *  Returns:
+ *      The folded string.
+ *
+ *  Comments:
+ *      None.
+ */
+std::string FoldCase(std::string_view input, bool unicode)
+{
+    std::string output;
+
+    FoldCase(input, output, unicode);
+
+    return output;
+}
+
+} // namespace Terra::ProgramOptions
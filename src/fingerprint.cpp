@@ -0,0 +1,193 @@
+/*
+ *  fingerprint.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the Fingerprint object, which computes a stable
+ *      64-bit hash over a sequence of strings and integers.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <terra/program_options/fingerprint.h>
+
+namespace Terra::ProgramOptions
+{
+
+namespace
+{
+
+// Multiplier and shift used by the mixing function
+constexpr std::uint64_t Multiplier = 0xc6a4a7935bd1e995ULL;
+constexpr unsigned Shift = 47;
+
+// Initial state combined with the seed
+constexpr std::uint64_t Initial_State = 0x9e3779b97f4a7c15ULL;
+
+/*
+ *  LoadLittleEndian()
+ *
+ *  Description:
+ *      This function will assemble up to eight octets into an integer,
+ *      treating the first octet as the least significant.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The octets to load, of which at most eight are used.
+ *
+ *  Returns:
+ *      The assembled integer.
+ *
+ *  Comments:
+ *      The compiler reduces this to a single load on little-endian
+ *      platforms.
+ */
+std::uint64_t LoadLittleEndian(std::string_view data) noexcept
+{
+    std::uint64_t value = 0;
+    std::size_t length = (data.size() < 8) ? data.size() : 8;
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        value |= std::uint64_t(static_cast<unsigned char>(data[i])) << (i * 8);
+    }
+
+    return value;
+}
+
+} // namespace
+
+/*
+ *  Fingerprint::Fingerprint()
+ *
+ *  Description:
+ *      Constructor for the Fingerprint object.
+ *
+ *  Parameters:
+ *      seed [in]
+ *          Value from which to start, allowing fingerprints to be chained
+ *          (e.g., by seeding with the fingerprint of an option specification).
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+Fingerprint::Fingerprint(std::uint64_t seed) noexcept :
+    state{Initial_State ^ (seed * Multiplier)}
+{
+}
+
+/*
+ *  Fingerprint::Update()
+ *
+ *  Description:
+ *      This function will add the given string to the fingerprint.  The
+ *      length of the string is added first, followed by the string contents.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The string to add to the fingerprint.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Fingerprint::Update(std::string_view data) noexcept
+{
+    Mix(data.size());
+
+    while (data.size() >= 8)
+    {
+        Mix(LoadLittleEndian(data));
+        data.remove_prefix(8);
+    }
+
+    if (!data.empty()) Mix(LoadLittleEndian(data));
+}
+
+/*
+ *  Fingerprint::Update()
+ *
+ *  Description:
+ *      This function will add the given integer to the fingerprint.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The integer to add to the fingerprint.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Fingerprint::Update(std::uint64_t value) noexcept
+{
+    Mix(value);
+}
+
+/*
+ *  Fingerprint::Value()
+ *
+ *  Description:
+ *      This function will return the fingerprint of the data added so far.
+ *      More data may be added after calling this function.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The 64-bit fingerprint.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t Fingerprint::Value() const noexcept
+{
+    std::uint64_t value = state;
+
+    value ^= value >> Shift;
+    value *= Multiplier;
+    value ^= value >> Shift;
+
+    return value;
+}
+
+/*
+ *  Fingerprint::Mix()
+ *
+ *  Description:
+ *      This function will mix a block of eight octets into the state.
+ *
+ *  Parameters:
+ *      block [in]
+ *          The block to mix into the state.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Fingerprint::Mix(std::uint64_t block) noexcept
+{
+    block *= Multiplier;
+    block ^= block >> Shift;
+    block *= Multiplier;
+
+    state ^= block;
+    state *= Multiplier;
+}
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,150 @@
+/*
+ *  intern_table.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the InternTable object, which holds a single
+ *      copy of each distinct string given to it.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <terra/program_options/intern_table.h>
+
+namespace Terra::ProgramOptions
+{
+
+/*
+ *  InternTable::Intern()
+ *
+ *  Description:
+ *      This function will return the handle of the given string, inserting
+ *      a copy of the string into the table if it is not already present.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The string to intern.
+ *
+ *  Returns:
+ *      The handle identifying the string.
+ *
+ *  Comments:
+ *      A shared lock is held while looking for the string, so only strings
+ *      not already in the table require exclusive access.
+ */
+InternedValue InternTable::Intern(std::string_view value)
+{
+    // Look for the string, which is the common case
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+
+        auto it = index.find(value);
+        if (it != index.end()) return InternedValue{it->second};
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    // Another thread may have inserted the string before the lock was taken
+    auto it = index.find(value);
+    if (it != index.end()) return InternedValue{it->second};
+
+    if (strings.size() >= std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::length_error("intern table is full");
+    }
+
+    const auto id = static_cast<std::uint32_t>(strings.size());
+
+    // The index refers to the copy held in the table, which does not move
+    strings.emplace_back(value);
+    index.emplace(strings.back(), id);
+
+    return InternedValue{id};
+}
+
+/*
+ *  InternTable::Find()
+ *
+ *  Description:
+ *      This function will return the handle of the given string if it is
+ *      held in the table, without inserting it.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The string to find.
+ *
+ *  Returns:
+ *      The handle identifying the string, or an empty optional if the
+ *      string is not in the table.
+ *
+ *  Comments:
+ *      This allows a program to obtain the handle of a value of interest
+ *      once and then compare handles.
+ */
+std::optional<InternedValue> InternTable::Find(std::string_view value) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    auto it = index.find(value);
+    if (it == index.end()) return {};
+
+    return InternedValue{it->second};
+}
+
+/*
+ *  InternTable::View()
+ *
+ *  Description:
+ *      This function will return a view of the string identified by the
+ *      given handle.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          A handle returned by this table.
+ *
+ *  Returns:
+ *      A view of the string, which remains valid for the life of the table.
+ *
+ *  Comments:
+ *      An exception is thrown if the handle was not returned by this table.
+ */
+std::string_view InternTable::View(InternedValue handle) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    return strings.at(handle.id);
+}
+
+/*
+ *  InternTable::Size()
+ *
+ *  Description:
+ *      This function will return the number of strings held in the table.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of distinct strings interned.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t InternTable::Size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    return strings.size();
+}
+
+} // namespace Terra::ProgramOptions
@@ -0,0 +1,224 @@
+/*
+ *  keyed_hash.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the KeyedHash() functions, which compute
+ *      SipHash-1-3 using a key chosen at random once per process.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <bit>
+#include <chrono>
+#include <random>
+#include <terra/program_options/keyed_hash.h>
+
+namespace Terra::ProgramOptions
+{
+
+namespace
+{
+
+// Define the 128-bit key used by the hash
+struct HashKey
+{
+    std::uint64_t k0;
+    std::uint64_t k1;
+};
+
+/*
+ *  GenerateKey()
+ *
+ *  Description:
+ *      This function will choose a random key.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The random key.
+ *
+ *  Comments:
+ *      Should no random device be available, the key is formed from the
+ *      time and the address of the key, which still differ between
+ *      processes.
+ */
+HashKey GenerateKey() noexcept
+{
+    HashKey key{};
+
+    try
+    {
+        std::random_device device;
+        std::uniform_int_distribution<std::uint64_t> distribution;
+
+        key.k0 = distribution(device);
+        key.k1 = distribution(device);
+    }
+    catch (...)
+    {
+        key.k0 = static_cast<std::uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+        key.k1 = reinterpret_cast<std::uintptr_t>(&key) ^
+                 static_cast<std::uint64_t>(
+                 std::chrono::system_clock::now().time_since_epoch().count());
+    }
+
+    return key;
+}
+
+/*
+ *  LoadLittleEndian()
+ *
+ *  Description:
+ *      This function will assemble up to eight octets into an integer,
+ *      treating the first octet as the least significant.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The octets to load, of which at most eight are used.
+ *
+ *  Returns:
+ *      The assembled integer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t LoadLittleEndian(std::string_view data) noexcept
+{
+    std::uint64_t value = 0;
+    std::size_t length = (data.size() < 8) ? data.size() : 8;
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        value |= std::uint64_t(static_cast<unsigned char>(data[i])) << (i * 8);
+    }
+
+    return value;
+}
+
+// Define the state of SipHash
+struct SipState
+{
+    std::uint64_t v0;
+    std::uint64_t v1;
+    std::uint64_t v2;
+    std::uint64_t v3;
+
+    // Perform one SipRound
+    void Round() noexcept
+    {
+        v0 += v1;
+        v1 = std::rotl(v1, 13);
+        v1 ^= v0;
+        v0 = std::rotl(v0, 32);
+        v2 += v3;
+        v3 = std::rotl(v3, 16);
+        v3 ^= v2;
+        v0 += v3;
+        v3 = std::rotl(v3, 21);
+        v3 ^= v0;
+        v2 += v1;
+        v1 = std::rotl(v1, 17);
+        v1 ^= v2;
+        v2 = std::rotl(v2, 32);
+    }
+
+    // Compress a block of eight octets (one round)
+    void Compress(std::uint64_t block) noexcept
+    {
+        v3 ^= block;
+        Round();
+        v0 ^= block;
+    }
+
+    // Finalize the hash (three rounds)
+    std::uint64_t Finalize() noexcept
+    {
+        v2 ^= 0xff;
+        Round();
+        Round();
+        Round();
+
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+};
+
+} // namespace
+
+/*
+ *  KeyedHash()
+ *
+ *  Description:
+ *      This function will compute the keyed hash of the given string.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The string to hash.
+ *
+ *  Returns:
+ *      The 64-bit hash of the string.
+ *
+ *  Comments:
+ *      The key is chosen when this is first called; initialization of the
+ *      static key is thread-safe.
+ */
+std::uint64_t KeyedHash(std::string_view data) noexcept
+{
+    static const HashKey key = GenerateKey();
+
+    SipState state{key.k0 ^ 0x736f6d6570736575ULL,
+                   key.k1 ^ 0x646f72616e646f6dULL,
+                   key.k0 ^ 0x6c7967656e657261ULL,
+                   key.k1 ^ 0x7465646279746573ULL};
+    const std::uint64_t length = data.size();
+
+    while (data.size() >= 8)
+    {
+        state.Compress(LoadLittleEndian(data));
+        data.remove_prefix(8);
+    }
+
+    // The last block holds the remaining octets and the length
+    state.Compress(LoadLittleEndian(data) | (length << 56));
+
+    return state.Finalize();
+}
+
+/*
+ *  KeyedHash()
+ *
+ *  Description:
+ *      This function will compute the keyed hash of the given integer.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The integer to hash.
+ *
+ *  Returns:
+ *      The 64-bit hash of the integer.
+ *
+ *  Comments:
+ *      The integer is hashed as its eight octets in little-endian order.
+ */
+std::uint64_t KeyedHash(std::uint64_t value) noexcept
+{
+    char octets[8];
+
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        octets[i] = static_cast<char>((value >> (i * 8)) & 0xff);
+    }
+
+    return KeyedHash(std::string_view(octets, sizeof(octets)));
+}
+
+} // namespace Terra::ProgramOptions
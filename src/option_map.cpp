@@ -0,0 +1,435 @@
+/*
+ *  option_map.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file implements the OptionMap object, which holds the key/value
+ *      pairs given for a map option in a flat, open-addressing hash table.
+ *
+ *  Portability Issues:
+ *      Requires C++20 or later.
+ */
+
+#include <stdexcept>
+#include <terra/program_options/option_map.h>
+#include <terra/program_options/keyed_hash.h>
+
+namespace Terra::ProgramOptions
+{
+
+/*
+ *  OptionMap::Insert()
+ *
+ *  Description:
+ *      This function will insert the given key/value pair into the map,
+ *      handling a key already present according to the given policy.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to insert.
+ *
+ *      value [in]
+ *          The value associated with the key.
+ *
+ *      duplicate_keys [in]
+ *          Indicates how to handle a key that is already present.
+ *
+ *  Returns:
+ *      True if the pair was inserted, or false if the key is already present
+ *      and the policy is DuplicateKeys::Error, in which case the map is not
+ *      modified.
+ *
+ *  Comments:
+ *      Views previously returned by the map may be invalidated.
+ */
+bool OptionMap::Insert(std::string_view key,
+                       std::string_view value,
+                       DuplicateKeys duplicate_keys)
+{
+    const std::uint64_t hash = HashKey(key);
+    const std::uint32_t head = FindHead(key, hash);
+
+    if (head != No_Entry)
+    {
+        switch (duplicate_keys)
+        {
+            case DuplicateKeys::Error:
+                return false;
+
+            case DuplicateKeys::Collect:
+            {
+                const std::uint32_t value_offset = Append(value);
+                const auto index = static_cast<std::uint32_t>(entries.size());
+
+                entries.push_back({hash,
+                                   entries[head].key_offset,
+                                   entries[head].key_length,
+                                   value_offset,
+                                   static_cast<std::uint32_t>(value.size()),
+                                   No_Entry,
+                                   No_Entry});
+                entries[entries[head].last].next = index;
+                entries[head].last = index;
+                break;
+            }
+
+            default:
+                entries[head].value_offset = Append(value);
+                entries[head].value_length =
+                                    static_cast<std::uint32_t>(value.size());
+                break;
+        }
+
+        return true;
+    }
+
+    // Keep the table at most half full
+    if (2 * (key_count + 1) > table.size()) Grow();
+
+    const auto index = static_cast<std::uint32_t>(entries.size());
+    const std::uint32_t key_offset = Append(key);
+    const std::uint32_t value_offset = Append(value);
+
+    entries.push_back({hash,
+                       key_offset,
+                       static_cast<std::uint32_t>(key.size()),
+                       value_offset,
+                       static_cast<std::uint32_t>(value.size()),
+                       No_Entry,
+                       index});
+
+    // Place the entry in the first empty position following its hash
+    const std::size_t mask = table.size() - 1;
+    std::size_t position = hash & mask;
+    while (table[position] != 0) position = (position + 1) & mask;
+    table[position] = index + 1;
+
+    key_count++;
+
+    return true;
+}
+
+/*
+ *  OptionMap::Clear()
+ *
+ *  Description:
+ *      This function will remove all key/value pairs from the map, retaining
+ *      the allocated storage for reuse.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void OptionMap::Clear() noexcept
+{
+    text.clear();
+    entries.clear();
+    table.assign(table.size(), 0);
+    key_count = 0;
+}
+
+/*
+ *  OptionMap::Reserve()
+ *
+ *  Description:
+ *      This function will reserve storage for the given number of pairs,
+ *      such that inserting that many distinct keys does not grow the table.
+ *
+ *  Parameters:
+ *      count [in]
+ *          The number of pairs for which to reserve storage.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void OptionMap::Reserve(std::size_t count)
+{
+    entries.reserve(count);
+
+    while (2 * count > table.size()) Grow();
+}
+
+/*
+ *  OptionMap::Contains()
+ *
+ *  Description:
+ *      This function will determine whether the given key is in the map.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to find.
+ *
+ *  Returns:
+ *      True if the key is in the map, false if not.
+ *
+ *  Comments:
+ *      None.
+ */
+bool OptionMap::Contains(std::string_view key) const noexcept
+{
+    return FindHead(key, HashKey(key)) != No_Entry;
+}
+
+/*
+ *  OptionMap::Find()
+ *
+ *  Description:
+ *      This function will find the value associated with the given key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to find.
+ *
+ *  Returns:
+ *      A view of the value, or an empty optional if the key is not in the
+ *      map.  If values are collected, the first value given is returned.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::string_view> OptionMap::Find(
+                                        std::string_view key) const noexcept
+{
+    const std::uint32_t head = FindHead(key, HashKey(key));
+
+    if (head == No_Entry) return {};
+
+    return EntryValue(entries[head]);
+}
+
+/*
+ *  OptionMap::FindAll()
+ *
+ *  Description:
+ *      This function will return all values associated with the given key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to find.
+ *
+ *  Returns:
+ *      A range over views of the values in the order given, which is empty
+ *      if the key is not in the map.
+ *
+ *  Comments:
+ *      None.
+ */
+OptionMap::Values OptionMap::FindAll(std::string_view key) const noexcept
+{
+    return Values(ValueIterator(this, FindHead(key, HashKey(key))),
+                  std::default_sentinel);
+}
+
+/*
+ *  OptionMap::Count()
+ *
+ *  Description:
+ *      This function will return the number of values associated with the
+ *      given key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to find.
+ *
+ *  Returns:
+ *      The number of values, which is zero if the key is not in the map.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t OptionMap::Count(std::string_view key) const noexcept
+{
+    std::size_t count = 0;
+
+    for (std::uint32_t i = FindHead(key, HashKey(key)); i != No_Entry;
+         i = entries[i].next)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ *  OptionMap::Size()
+ *
+ *  Description:
+ *      This function will return the number of distinct keys in the map.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of distinct keys.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t OptionMap::Size() const noexcept
+{
+    return key_count;
+}
+
+/*
+ *  OptionMap::Empty()
+ *
+ *  Description:
+ *      This function will determine whether the map is empty.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      True if the map holds no keys, false if not.
+ *
+ *  Comments:
+ *      None.
+ */
+bool OptionMap::Empty() const noexcept
+{
+    return key_count == 0;
+}
+
+/*
+ *  OptionMap::HashKey()
+ *
+ *  Description:
+ *      This function will compute the hash of the given key.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to hash.
+ *
+ *  Returns:
+ *      The 64-bit hash of the key.
+ *
+ *  Comments:
+ *      A keyed hash is used, so keys cannot be chosen to select the same
+ *      entries of the table and make insertion take quadratic time.
+ */
+std::uint64_t OptionMap::HashKey(std::string_view key) noexcept
+{
+    return KeyedHash(key);
+}
+
+/*
+ *  OptionMap::FindHead()
+ *
+ *  Description:
+ *      This function will find the first entry for the given key by probing
+ *      the table from the position selected by the key's hash until the key
+ *      or an empty position is found.
+ *
+ *  Parameters:
+ *      key [in]
+ *          The key to find.
+ *
+ *      hash [in]
+ *          The hash of the key.
+ *
+ *  Returns:
+ *      The index of the first entry for the key, or No_Entry if the key is
+ *      not in the map.
+ *
+ *  Comments:
+ *      Hashes are compared before keys, so the text of other keys is rarely
+ *      examined.
+ */
+std::uint32_t OptionMap::FindHead(std::string_view key,
+                                  std::uint64_t hash) const noexcept
+{
+    if (table.empty()) return No_Entry;
+
+    const std::size_t mask = table.size() - 1;
+
+    for (std::size_t position = hash & mask; table[position] != 0;
+         position = (position + 1) & mask)
+    {
+        const std::uint32_t index = table[position] - 1;
+        const Entry &entry = entries[index];
+
+        if ((entry.hash == hash) && (EntryKey(entry) == key)) return index;
+    }
+
+    return No_Entry;
+}
+
+/*
+ *  OptionMap::Grow()
+ *
+ *  Description:
+ *      This function will double the size of the table (to at least 16
+ *      positions) and reinsert the first entry of each key.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void OptionMap::Grow()
+{
+    const std::size_t size = table.empty() ? 16 : 2 * table.size();
+    const std::size_t mask = size - 1;
+
+    table.assign(size, 0);
+
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].last == No_Entry) continue;
+
+        std::size_t position = entries[i].hash & mask;
+        while (table[position] != 0) position = (position + 1) & mask;
+        table[position] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+/*
+ *  OptionMap::Append()
+ *
+ *  Description:
+ *      This function will append the given data to the text buffer.
+ *
+ *  Parameters:
+ *      data [in]
+ *          The data to append.
+ *
+ *  Returns:
+ *      The offset of the data within the text buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if the buffer would exceed the size that may
+ *      be addressed by an entry.
+ */
+std::uint32_t OptionMap::Append(std::string_view data)
+{
+    const std::size_t offset = text.size();
+
+    if (data.size() >= No_Entry - offset)
+    {
+        throw std::length_error("option map text is too large");
+    }
+
+    text.append(data);
+
+    return static_cast<std::uint32_t>(offset);
+}
+
+} // namespace Terra::ProgramOptions
@@ -17,14 +17,129 @@
  *      Requires C++20 or later.
  */
 
-#include <sstream>
 #include <algorithm>
-#include <cctype>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <span>
+#include <sstream>
 #include <terra/program_options/program_options.h>
+#include <terra/program_options/basic_parser.h>
+#include <terra/program_options/fingerprint.h>
+#include <terra/program_options/keyed_hash.h>
+#include <terra/program_options/option_binding.h>
+#include <terra/program_options/value_conversion.h>
 
 namespace Terra::ProgramOptions
 {
 
+namespace
+{
+
+// Apply the given function to the vector holding typed values, if any
+template<typename Variant, typename Func>
+void VisitTypedValues(Variant &typed_values, const Func &func)
+{
+    std::visit(
+        [&func](auto &values)
+        {
+            using T = std::remove_cvref_t<decltype(values)>;
+
+            if constexpr (!std::is_same_v<T, std::monostate> &&
+                          !std::is_same_v<T, OptionMap>)
+            {
+                func(values);
+            }
+        },
+        typed_values);
+}
+
+// Apply the given function to the vector holding numeric typed values, if
+// any (i.e., excluding interval sets, maps, and interned strings)
+template<typename Variant, typename Func>
+void VisitNumericValues(Variant &typed_values, const Func &func)
+{
+    std::visit(
+        [&func](auto &values)
+        {
+            using T = std::remove_cvref_t<decltype(values)>;
+
+            if constexpr (!std::is_same_v<T, std::monostate> &&
+                          !std::is_same_v<T, OptionMap> &&
+                          !std::is_same_v<T, std::vector<Interval>> &&
+                          !std::is_same_v<T, std::vector<InternedValue>>)
+            {
+                func(values);
+            }
+        },
+        typed_values);
+}
+
+// Convert a typed value to the numeric type T, throwing std::invalid_argument
+// if it is not representable and std::out_of_range if outside [min, max]
+template<NumericType T, typename V>
+T ConvertTypedValue(V value, T min, T max)
+{
+    T result{};
+
+    if constexpr (std::is_same_v<V, bool>)
+    {
+        // Boolean values convert as 0 or 1
+        return ConvertTypedValue(static_cast<std::uint64_t>(value), min, max);
+    }
+    else if constexpr (std::is_floating_point_v<V> && std::is_integral_v<T>)
+    {
+        // Only whole numbers may be converted to integral types
+        if (std::trunc(value) != value)
+        {
+            throw std::invalid_argument("value is not a whole number");
+        }
+        if ((value < static_cast<V>(std::numeric_limits<T>::lowest())) ||
+            (value > static_cast<V>(std::numeric_limits<T>::max())))
+        {
+            ThrowRangeError(min, max);
+        }
+        result = static_cast<T>(value);
+    }
+    else if constexpr (std::is_integral_v<V> && std::is_integral_v<T>)
+    {
+        if (!std::in_range<T>(value)) ThrowRangeError(min, max);
+        result = static_cast<T>(value);
+    }
+    else
+    {
+        result = static_cast<T>(value);
+    }
+
+    if ((result < min) || (result > max)) ThrowRangeError(min, max);
+
+    return result;
+}
+
+// Select the entry of a choice table for a value having the given
+// fingerprint, using the displacement of the value's bucket
+inline std::size_t DisplaceChoice(std::uint64_t hash,
+                                  std::uint32_t displacement,
+                                  std::uint64_t mask) noexcept
+{
+    hash ^= (displacement + 1) * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 31;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 29;
+
+    return static_cast<std::size_t>(hash & mask);
+}
+
+// Select the bucket of a choice table for a value having the given fingerprint
+inline std::size_t ChoiceBucket(std::uint64_t hash, std::uint64_t mask) noexcept
+{
+    return static_cast<std::size_t>((hash >> 32) & mask);
+}
+
+} // namespace
+
 /*
  *  Parser::Parser()
  *
@@ -91,8 +206,19 @@ Parser::Parser(Options options,
     long_flags{std::move(long_flags)},
     option_value_separator{std::move(option_value_separator)},
     case_insensitive{case_insensitive},
-    option_map{}
+    short_option_index{},
+    unicode_folding{false},
+    epoch{0},
+    argument_position{0},
+    parse_strategy{ParseStrategy::SinglePass},
+    counting_pass{false},
+    option_order{OptionOrder::Interleaved},
+    remainder_position{0},
+    unknown_options{UnknownOptions::Reject},
+    spec_fingerprint{0}
 {
+    // Build the index used to match options
+    BuildOptionIndex();
 }
 
 /*
@@ -129,7 +255,8 @@ Parser::Parser(Options options,
  *      options are invalid or if there is an error with the options flags.
  *
  *  Comments:
- *      None.
+ *      Any constraints previously set are removed, as they refer to options
+ *      by name.
  */
 void Parser::SetOptions(const Options &options,
                         const std::vector<std::string> &short_flags,
@@ -144,6 +271,12 @@ void Parser::SetOptions(const Options &options,
     this->option_value_separator = option_value_separator;
     this->case_insensitive = case_insensitive;
 
+    // Constraints refer to the previous options
+    constraints.clear();
+    compiled_constraints.clear();
+    constraint_masks.clear();
+    required_mask = OptionPresence();
+
     // Clear any previously processed options
     ClearOptions();
 
@@ -152,6 +285,9 @@ void Parser::SetOptions(const Options &options,
 
     // Validate the options
     CheckOptions();
+
+    // Build the index used to match options
+    BuildOptionIndex();
 }
 
 /*
@@ -168,1026 +304,3954 @@ void Parser::SetOptions(const Options &options,
  *      Nothing.
  *
  *  Comments:
- *      None.
+ *      This function takes constant time, regardless of the number of options
+ *      or values previously parsed (aside from clearing the presence and
+ *      counts of each distinct option given).  It merely advances the parse
+ *      epoch, so that every option slot becomes stale.  A stale slot is
+ *      reset when it is next used, emptying its vector of values in place.
+ *      Thus, memory allocated to hold option values is retained, and a
+ *      Parser that is reused to parse arguments repeatedly need not allocate
+ *      memory again for similar command-lines.
  */
 void Parser::ClearOptions()
 {
-    option_map.clear();
+    epoch++;
+    remainder_position = 0;
+    unknown_positions.clear();
+
+    // Clear the presence and counts of the options given
+    for (const auto option_index : given_options)
+    {
+        presence.Reset(option_index);
+        option_counts[option_index] = 0;
+    }
+    given_options.clear();
 }
 
 /*
- *  Parser::ParseArguments()
+ *  Parser::UseOptionSlot()
  *
  *  Description:
- *      This function will parse command-line arguments.
+ *      This function will return the slot at the given index for the purpose
+ *      of storing an option instance, first resetting the slot if it was last
+ *      used in a prior parse epoch.
  *
  *  Parameters:
- *      argc [in]
- *          A count of the number of strings in the arv[] vector.  Note that
- *          this is precisely the same argument as used in C/C++ code in the
- *          main() function.  Thus, this must always be >= 1, since the first
- *          element in argv[] is the name of the program.  If argc is < 1,
- *          this function has no effect.
- *
- *      argv [in]
- *          A vector of null-terminated strings that are parsed by this object.
- *          The first element of the array is assumed to be the executable name
- *          and will be ignored.
+ *      slot_index [in]
+ *          The index of the slot to use.
  *
  *  Returns:
- *      Nothing, but if the user provides invalid input an exception will be
- *      thrown.
+ *      A reference to the slot, which is current in this parse epoch.
  *
  *  Comments:
  *      None.
  */
-void Parser::ParseArguments(const int argc, const char *const argv[])
+Parser::OptionSlot &Parser::UseOptionSlot(std::size_t slot_index)
 {
-    if (argc > 0)
+    OptionSlot &slot = option_slots[slot_index];
+
+    if (slot.epoch != epoch)
     {
-        ParseArguments(std::vector<std::string_view>(argv, argv + argc));
+        slot.epoch = epoch;
+        slot.count = 0;
+        slot.values.clear();
+        VisitTypedValues(slot.typed_values,
+                         [](auto &values) { values.clear(); });
+        if (auto *map = std::get_if<OptionMap>(&slot.typed_values))
+        {
+            map->Clear();
+        }
+        std::fill(slot.value_index.begin(),
+                  slot.value_index.end(),
+                  IndexedValue{0, 0});
     }
+
+    return slot;
 }
 
 /*
- *  Parser::ParseArguments()
+ *  Parser::SlotCount()
  *
  *  Description:
- *      This function will parse command-line arguments.
+ *      This function will return the number of instances recorded in the
+ *      given slot during the current parse epoch.
  *
  *  Parameters:
- *      arguments [in]
- *          A vector of user-provided program arguments.  This vector must
- *          include the command name (or some string, even if empty) as the
- *          first element of the vector to parallel the argv[] array.  The
- *          first element of the vector is skipped over when parsing.
+ *      slot [in]
+ *          The slot to examine.
  *
  *  Returns:
- *      Nothing, but if the user provides invalid input an exception will be
- *      thrown.
+ *      The number of instances, which is zero if the slot is stale.
  *
  *  Comments:
  *      None.
  */
-void Parser::ParseArguments(const std::vector<std::string> &arguments)
+std::size_t Parser::SlotCount(const OptionSlot &slot) const
 {
-    ParseArguments(std::vector<std::string_view>(arguments.begin(),
-                                                 arguments.end()));
+    return (slot.epoch == epoch) ? slot.count : 0;
 }
 
 /*
- *  Parser::ParseArguments()
+ *  Parser::SetConstraints()
  *
  *  Description:
- *      This function will parse command-line arguments.
+ *      This function will set the constraints among options that are checked
+ *      when ParseArguments() completes.  Each constraint is compiled into a
+ *      bitmask over option indices, so checking a constraint requires only a
+ *      few word operations against the bitset of options given, regardless
+ *      of the length of the option names.
  *
  *  Parameters:
- *      arguments [in]
- *          A vector of user-provided program arguments.  This vector must
- *          include the command name (or some string, even if empty) as the
- *          first element of the vector to parallel the argv[] array.  The
- *          first element of the vector is skipped over when parsing.
+ *      constraints [in]
+ *          The constraints, each naming the options it relates.  A Required
+ *          constraint requires every option named to be given, an Exclusive
+ *          constraint permits at most one of the options named to be given,
+ *          and a Requires constraint requires all other options named to be
+ *          given if the first option named is given.
  *
  *  Returns:
- *      Nothing, but if the user provides invalid input an exception will be
- *      thrown.
+ *      Nothing, though this function will throw a SpecificationException if
+ *      a constraint names an unknown option or too few options.
  *
  *  Comments:
- *      None.
+ *      Any parsed options are cleared.  Constraints are removed by
+ *      SetOptions(), so they should be set after the options.
  */
-void Parser::ParseArguments(const std::vector<std::string_view> &arguments)
+void Parser::SetConstraints(const Constraints &constraints)
 {
-    // There is nothing to do if the number arguments is <= 1
-    if (arguments.size() <= 1) return;
+    const std::size_t words = presence.Words().size();
+    std::vector<CompiledConstraint> compiled;
+    std::vector<std::uint64_t> masks;
+    OptionPresence required(options.size());
 
-    // Iterate over each of the arguments presented, ignoring the first element
-    // since it is the name of the executed command
-    for (std::size_t i = 1; i < arguments.size(); i++)
+    for (std::size_t i = 0; i < constraints.size(); i++)
     {
-        // Is there a parameter to pass?
-        std::optional<std::string_view> parameter;
+        const Constraint &constraint = constraints[i];
+        const std::size_t minimum =
+                        (constraint.type == ConstraintType::Required) ? 1 : 2;
+
+        if (constraint.options.size() < minimum)
+        {
+            throw SpecificationException(
+                "Constraint " + std::to_string(i) + " names too few options",
+                OptionsError::InvalidConstraint);
+        }
+
+        // Required constraints are merged, as they are checked together
+        if (constraint.type != ConstraintType::Required)
+        {
+            compiled.push_back({constraint.type, i, 0, masks.size()});
+            masks.resize(masks.size() + words, 0);
+        }
+
+        for (std::size_t j = 0; j < constraint.options.size(); j++)
+        {
+            auto it = option_slot_index.find(constraint.options[j]);
+            if ((it == option_slot_index.end()) ||
+                ((*it).second == options.size()))
+            {
+                throw SpecificationException(
+                    "Constraint " + std::to_string(i) +
+                        " names an unknown option: " + constraint.options[j],
+                    OptionsError::InvalidConstraint);
+            }
+
+            const std::size_t option_index = (*it).second;
+
+            // The first option of a Requires constraint triggers the check
+            if ((constraint.type == ConstraintType::Requires) && (j == 0))
+            {
+                compiled.back().trigger = option_index;
+                continue;
+            }
 
-        if (i < (arguments.size() - 1)) parameter = arguments[i + 1];
+            if (constraint.type == ConstraintType::Required)
+            {
+                required.Set(option_index);
+                continue;
+            }
 
-        // Process the current argument, returning true if the next argument
-        // (labeled parameter here) was also consumed
-        if (ProcessArgument(arguments[i], parameter)) i++;
+            masks[compiled.back().mask_offset + option_index / 64] |=
+                                    std::uint64_t(1) << (option_index % 64);
+        }
     }
+
+    this->constraints = constraints;
+    compiled_constraints = std::move(compiled);
+    constraint_masks = std::move(masks);
+    required_mask = std::move(required);
+
+    // Clear parsed options and update the specification fingerprint
+    ClearOptions();
+    UpdateSpecFingerprint();
 }
 
 /*
- *  Parser::OptionGiven()
+ *  Parser::SetParseStrategy()
  *
  *  Description:
- *      This function will return true if the specified option name was given
- *      by the user or false it was not.
+ *      This function will set the strategy used to store values when
+ *      ParseArguments() is subsequently called.  With ParseStrategy::TwoPass,
+ *      the arguments are first processed only to count the instances of each
+ *      option, allowing storage to be reserved once before storing values.
+ *      This avoids repeatedly growing storage for options given a very large
+ *      number of times, at the cost of matching each argument twice.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name to use to see if an option was given.
+ *      strategy [in]
+ *          The strategy to use when parsing arguments.
  *
  *  Returns:
- *      True if the specified option was given by the user, false it it was not.
+ *      Nothing.
  *
  *  Comments:
- *      None.
+ *      Arguments given as a single-pass range are always parsed in a single
+ *      pass.
  */
-bool Parser::OptionGiven(const std::string &option_name)
+void Parser::SetParseStrategy(ParseStrategy strategy)
 {
-    return option_map.contains(option_name);
+    parse_strategy = strategy;
 }
 
 /*
- *  Parser::GetOptionCount()
+ *  Parser::SetTerminators()
  *
  *  Description:
- *      This function will return a count of the number of times the specified
- *      option was given.  The string represents the option name.  An empty
- *      string refers to any command-line arguments that are not part
- *      of the command-line options (e.g., a list of filenames or other
- *      arguments given on the command-line).
+ *      This function will set the arguments that end option parsing (e.g.,
+ *      "--").  The arguments following a terminator are not parsed or
+ *      stored, but may be retrieved using GetRemainder().
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a count is desired.
+ *      terminators [in]
+ *          The arguments that end option parsing, which are matched exactly.
+ *          If empty (the default), no argument ends option parsing and an
+ *          argument consisting only of a long flag is stored with the
+ *          arguments not associated with an option.
  *
  *  Returns:
- *      A count of the number of options having the specified option name
- *      was parsed.  In the case of an empty string, it is a count of
- *      the unaffiliated command-line option strings observed.
+ *      Nothing.
  *
  *  Comments:
- *      None.
+ *      Any parsed options are cleared.  A terminator given as the value of
+ *      an option expecting one (e.g., "--define --") is the option's value.
  */
-std::size_t Parser::GetOptionCount(const std::string &option_name)
+void Parser::SetTerminators(const std::vector<std::string> &terminators)
 {
-    auto it = option_map.find(option_name);
+    this->terminators = terminators;
 
-    if (it == option_map.end()) return 0;
-
-    return (*it).second.size();
+    // Clear parsed options and update the specification fingerprint
+    ClearOptions();
+    UpdateSpecFingerprint();
 }
 
 /*
- *  Parser::GetOptionString()
+ *  Parser::SetOptionOrder()
  *
  *  Description:
- *      This function will return the option string associated with a program
- *      option for which an argument is required.  In the case of arguments not
- *      associated with an option flag (e.g., a list of filenames or similar),
- *      those arguments are stored under the option name "" (empty string).
- *
- *      For options that do not have arguments, one should use OptionGiven()
- *      or GetOptionCount() to determine presence of the specified option.
- *
- *      If an option may be specified multiple times, one should call
- *      GetOptionStrings() instead of this function.  This function will return
- *      the argument string of only the first option string given if multiple
- *      instances are allowed.
+ *      This function will set whether options may follow arguments not
+ *      associated with an option.  With OptionOrder::OptionsFirst, parsing
+ *      stops at the first such argument (as with POSIX getopt()), which
+ *      begins the remainder retrieved using GetRemainder().
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a count is desired.
+ *      order [in]
+ *          The order in which options and other arguments may be given.
  *
  *  Returns:
- *      The string argument provided by the user for the given option name.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option was not
- *      given by the user.  One should first check for existence of an option
- *      by calling OptionGiven() or GetOptionCount().
+ *      Any parsed options are cleared.  An argument consisting only of flag
+ *      characters (e.g., "-") is not an option, so it also stops parsing
+ *      unless it is a terminator.
  */
-std::string Parser::GetOptionString(const std::string &option_name)
+void Parser::SetOptionOrder(OptionOrder order)
 {
-    return FindOptionStrings(option_name).front();
+    option_order = order;
+
+    // Clear parsed options and update the specification fingerprint
+    ClearOptions();
+    UpdateSpecFingerprint();
 }
 
 /*
- *  Parser::GetOptionStrings()
+ *  Parser::SetUnknownOptions()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will set how arguments that appear to be options, but
+ *      match no option, are handled.  Wrapper programs may pass such
+ *      options through to the program they run rather than rejecting them.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which values should be retrieved.
+ *      handling [in]
+ *          UnknownOptions::Reject (the default) throws an exception, while
+ *          UnknownOptions::PassThrough records the position of the argument
+ *          and UnknownOptions::PassThroughWithValues also records the
+ *          position of the following argument as the option's value if the
+ *          argument does not include a value and the following argument does
+ *          not appear to be an option.
  *
  *  Returns:
- *      A vector of string arguments given by the user for the specified option
- *      name.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().
+ *      Any parsed options are cleared.  A short option argument containing
+ *      any unknown option character (e.g., "-vz") is passed through whole,
+ *      and none of its option characters are stored.
  */
-std::vector<std::string> Parser::GetOptionStrings(
-                                                const std::string &option_name)
+void Parser::SetUnknownOptions(UnknownOptions handling)
 {
-    return FindOptionStrings(option_name);
+    unknown_options = handling;
+
+    // Clear parsed options and update the specification fingerprint
+    ClearOptions();
+    UpdateSpecFingerprint();
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::Reserve()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will reserve storage for the given number of values for
+ *      the specified option.  Since ClearOptions() retains storage, a Parser
+ *      reused in a loop need only reserve storage once.
  *
  *  Parameters:
  *      option_name [in]
- *          The option name for which a value should be retrieved.
+ *          The option name for which storage should be reserved.  Storage for
+ *          arguments not associated with an option flag is reserved using the
+ *          name "" (empty string).
  *
- *      option_values [out]
- *          The option values given for the requested option.
- *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
- *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *      count [in]
+ *          The number of values for which storage should be reserved.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      Options that do not expect a value or that are bound to a variable do
+ *      not require storage, so the request is ignored for such options, as
+ *      it is for unknown option names.  Storage is released if SetOptions()
+ *      or SetInternTable() is called, as those rebuild the storage for each
+ *      option, but is retained when other settings change.
  */
-template<> void Parser::GetOptionValues<short>(
-                                            const std::string &option_name,
-                                            std::vector<short> &option_values,
-                                            short min,
-                                            short max)
+void Parser::Reserve(const std::string &option_name, std::size_t count)
 {
-    // Define the converter function
-    auto converter = [min, max](const std::string &value) -> short
-                     {
-                         int i = std::stoi(value);
+    auto it = option_slot_index.find(option_name);
 
-                         if ((i < min) || (i > max))
-                         {
-                             throw std::out_of_range("value out of range");
-                         }
+    if (it == option_slot_index.end()) return;
 
-                         return static_cast<short>(i);
-                     };
+    OptionSlot &slot = option_slots[(*it).second];
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    if (StoresStrings((*it).second) && !InternsValues((*it).second))
+    {
+        slot.values.reserve(count);
+    }
+
+    VisitTypedValues(slot.typed_values,
+                     [count](auto &values) { values.reserve(count); });
+    if (auto *map = std::get_if<OptionMap>(&slot.typed_values))
+    {
+        map->Reserve(count);
+    }
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::ReservePending()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will reserve storage for the values counted during the
+ *      first pass of the ParseStrategy::TwoPass strategy, such that storing
+ *      the values in the second pass will not grow storage repeatedly.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
- *
- *      option_values [out]
- *          The option values given for the requested option.
- *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
- *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *      None.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      None.
  */
-template<> void Parser::GetOptionValues<unsigned short>(
-                                    const std::string &option_name,
-                                    std::vector<unsigned short> &option_values,
-                                    unsigned short min,
-                                    unsigned short max)
+void Parser::ReservePending()
 {
-    // Define the converter function
-    auto converter = [min, max](const std::string &value) -> unsigned short
-                     {
-                         int i = std::stoi(value);
+    for (std::size_t i = 0; i < option_slots.size(); i++)
+    {
+        if (option_slots[i].pending == 0) continue;
 
-                         if ((i < min) || (i > max))
-                         {
-                             throw std::out_of_range("value out of range");
-                         }
+        OptionSlot &slot = UseOptionSlot(i);
 
-                         return static_cast<unsigned short>(i);
-                     };
+        if (StoresStrings(i) && !InternsValues(i))
+        {
+            slot.values.reserve(slot.values.size() + slot.pending);
+        }
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+        VisitTypedValues(slot.typed_values,
+                         [&slot](auto &values)
+                         {
+                             values.reserve(values.size() + slot.pending);
+                         });
+        if (auto *map = std::get_if<OptionMap>(&slot.typed_values))
+        {
+            map->Reserve(map->Size() + slot.pending);
+        }
+
+        slot.pending = 0;
+    }
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::DiscardPending()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will discard the counts accumulated during the first
+ *      pass of the ParseStrategy::TwoPass strategy.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
- *
- *      option_values [out]
- *          The option values given for the requested option.
- *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
- *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *      None.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      None.
  */
-template<> void Parser::GetOptionValues<int>(
-                                            const std::string &option_name,
-                                            std::vector<int> &option_values,
-                                            int min,
-                                            int max)
+void Parser::DiscardPending()
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> int
-                     {
-                         return std::stoi(value);
-                     };
-
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    for (auto &slot : option_slots) slot.pending = 0;
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::PrepareBindings()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will prepare the variables bound to options before
+ *      arguments are parsed (e.g., clearing vectors to which values are
+ *      appended).
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
+ *      None.
  *
- *      option_values [out]
- *          The option values given for the requested option.
+ *  Returns:
+ *      Nothing.
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *  Comments:
+ *      None.
+ */
+void Parser::PrepareBindings()
+{
+    for (const auto i : bound_options) options[i].binding->Prepare();
+}
+
+/*
+ *  Parser::ApplyBindings()
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *  Description:
+ *      This function will complete the assignment of bound variables once
+ *      arguments are parsed.  Options that were not given are assigned their
+ *      default value (if any) and options that do not expect a value are
+ *      assigned the number of times they were given.
+ *
+ *  Parameters:
+ *      None.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing, though an exception will be thrown if the number of times an
+ *      option was given cannot be stored in the bound variable.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      Values for options that expect a value were already stored as the
+ *      arguments were parsed.
  */
-template<> void Parser::GetOptionValues<unsigned>(
-                                        const std::string &option_name,
-                                        std::vector<unsigned> &option_values,
-                                        unsigned min,
-                                        unsigned max)
+void Parser::ApplyBindings()
 {
-    // Define the converter function
-    auto converter = [min, max](const std::string &value) -> unsigned
-                     {
-                         unsigned long i = std::stoul(value);
+    for (const auto i : bound_options)
+    {
+        const Option &option = options[i];
+        const std::size_t count = SlotCount(option_slots[i]);
 
-                         if ((i < min) || (i > max))
-                         {
-                             throw std::out_of_range("value out of range");
-                         }
+        if (count == 0)
+        {
+            option.binding->ApplyDefault();
+            continue;
+        }
 
-                         return static_cast<unsigned>(i);
-                     };
+        if (option.parameter_expected) continue;
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+        try
+        {
+            option.binding->StoreCount(count);
+        }
+        catch (const std::out_of_range &e)
+        {
+            std::ostringstream oss;
+            oss << "Option \""
+                << option.name
+                << "\" given too many or too few times: "
+                << count
+                << " ["
+                << e.what()
+                << "]";
+            throw OptionsException(oss.str(), OptionsError::OptionValueError);
+        }
+        catch (const std::invalid_argument &)
+        {
+            std::ostringstream oss;
+            oss << "Option \""
+                << option.name
+                << "\" requires a value to be stored";
+            throw OptionsException(oss.str(), OptionsError::OptionValueError);
+        }
+    }
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::StoreConvertedValue()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will convert the given value and store it into the
+ *      variable bound to the given option or, if the option is not bound,
+ *      into the slot's typed values according to the option's ValueType.
+ *      For an option having choices, the index of the matching choice is
+ *      stored.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
- *
- *      option_values [out]
- *          The option values given for the requested option.
+ *      option_index [in]
+ *          The index of the option for which the value was given.
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *      slot [in]
+ *          The slot holding the instances of the option.
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *      value [in]
+ *          The value given for the option.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing, though an exception will be thrown if the value is invalid,
+ *      is outside the bounds given for the option, or is not one of the
+ *      option's choices.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      None.
  */
-template<> void Parser::GetOptionValues<long>(
-                                            const std::string &option_name,
-                                            std::vector<long> &option_values,
-                                            long min,
-                                            long max)
+void Parser::StoreConvertedValue(std::size_t option_index,
+                                 OptionSlot &slot,
+                                 const std::string_view value)
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> long
-                     {
-                         return std::stol(value);
-                     };
+    const Option &option = options[option_index];
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    try
+    {
+        if (!option.choices.empty())
+        {
+            const std::uint32_t choice = MatchChoice(option_index, value);
+
+            if (option.binding)
+            {
+                option.binding->StoreChoice(choice, value);
+            }
+            else
+            {
+                StoreChoice(option_index, slot, choice);
+            }
+        }
+        else if (option.binding)
+        {
+            option.binding->Store(value);
+        }
+        else
+        {
+            StoreTypedValue(option, slot, value);
+        }
+    }
+    catch (const std::invalid_argument &)
+    {
+        std::ostringstream oss;
+        oss << "Invalid argument value for \""
+            << option.name
+            << "\": "
+            << ErrorContext(value);
+        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+    }
+    catch (const std::out_of_range &e)
+    {
+        std::ostringstream oss;
+        oss << "Argument value for \""
+            << option.name
+            << "\" is out-of-range: "
+            << ErrorContext(value)
+            << " ["
+            << e.what()
+            << "]";
+        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+    }
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::StoreTypedValue()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will convert the given value according to the option's
+ *      ValueType, check it against the option's ValueRange, and append it to
+ *      the slot's typed values.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
- *
- *      option_values [out]
- *          The option values given for the requested option.
+ *      option [in]
+ *          The option for which the value was given.
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *      slot [in]
+ *          The slot holding the instances of the option.
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *      value [in]
+ *          The value given for the option.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing, though std::invalid_argument or std::out_of_range will be
+ *      thrown if the value is invalid or outside the option's range.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      None.
  */
-template<> void Parser::GetOptionValues<unsigned long>(
-                                    const std::string &option_name,
-                                    std::vector<unsigned long> &option_values,
-                                    unsigned long min,
-                                    unsigned long max)
+void Parser::StoreTypedValue(const Option &option,
+                             OptionSlot &slot,
+                             const std::string_view value)
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> unsigned long
-                     {
-                         return std::stoul(value);
-                     };
+    const ValueRange &range = option.value_range;
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    switch (option.value_type)
+    {
+        case ValueType::Integer:
+            std::get<std::vector<std::int64_t>>(slot.typed_values).push_back(
+                ConvertValue(value, range.integer_min, range.integer_max));
+            break;
+
+        case ValueType::Unsigned:
+            std::get<std::vector<std::uint64_t>>(slot.typed_values).push_back(
+                ConvertValue(value, range.unsigned_min, range.unsigned_max));
+            break;
+
+        case ValueType::Floating:
+            std::get<std::vector<double>>(slot.typed_values).push_back(
+                ConvertValue(value, range.floating_min, range.floating_max));
+            break;
+
+        case ValueType::Boolean:
+            std::get<std::vector<bool>>(slot.typed_values).push_back(
+                ConvertBoolean(value));
+            break;
+
+        case ValueType::IntervalSet:
+            StoreIntervals(option, slot, value);
+            break;
+
+        case ValueType::Map:
+            StoreMapEntry(option, slot, value);
+            break;
+
+        default:
+            slot.values.emplace_back(value);
+            break;
+    }
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::StoreIntervals()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will parse a comma-separated list of values and ranges
+ *      of values (e.g., "0-15,32-47,64") and add them to the slot's interval
+ *      set.  The new intervals are appended, then sorted and merged with the
+ *      existing intervals once, so that a long list given in any order is
+ *      stored in O(n log n) time.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
+ *      option [in]
+ *          The option for which the value was given.
  *
- *      option_values [out]
- *          The option values given for the requested option.
+ *      slot [in]
+ *          The slot holding the instances of the option.
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *      value [in]
+ *          The value given for the option.
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *  Returns:
+ *      Nothing, though std::invalid_argument or std::out_of_range will be
+ *      thrown if the value is invalid or outside the option's range.
+ *
+ *  Comments:
+ *      If an element of the list is invalid, the intervals stored for
+ *      earlier values are left unchanged.
+ */
+void Parser::StoreIntervals(const Option &option,
+                            OptionSlot &slot,
+                            const std::string_view value)
+{
+    const ValueRange &range = option.value_range;
+    auto &intervals = std::get<std::vector<Interval>>(slot.typed_values);
+    const std::size_t sorted_count = intervals.size();
+    std::string_view remaining = value;
+
+    // Remove the new intervals if an element is invalid, so the intervals
+    // stored remain sorted and merged
+    try
+    {
+        while (true)
+        {
+            const std::size_t comma = remaining.find(',');
+            const std::string_view element = remaining.substr(0, comma);
+            const std::size_t dash = element.find('-');
+            Interval interval{};
+
+            if (dash == std::string_view::npos)
+            {
+                interval.lower = ConvertValue(element,
+                                              range.unsigned_min,
+                                              range.unsigned_max);
+                interval.upper = interval.lower;
+            }
+            else
+            {
+                interval.lower = ConvertValue(element.substr(0, dash),
+                                              range.unsigned_min,
+                                              range.unsigned_max);
+                interval.upper = ConvertValue(element.substr(dash + 1),
+                                              range.unsigned_min,
+                                              range.unsigned_max);
+                if (interval.lower > interval.upper)
+                {
+                    throw std::invalid_argument("interval is reversed");
+                }
+            }
+
+            intervals.push_back(interval);
+
+            if (comma == std::string_view::npos) break;
+
+            remaining.remove_prefix(comma + 1);
+        }
+    }
+    catch (...)
+    {
+        intervals.resize(sorted_count);
+        throw;
+    }
+
+    // Sort and merge the new intervals once, rather than inserting each
+    MergeIntervals(intervals, sorted_count);
+}
+
+/*
+ *  Parser::StoreMapEntry()
+ *
+ *  Description:
+ *      This function will split the given value at the option's key
+ *      separator (e.g., "name=value") and insert the key and value into the
+ *      slot's map, applying the option's DuplicateKeys policy.  A value not
+ *      containing the separator is a key having an empty value.
+ *
+ *  Parameters:
+ *      option [in]
+ *          The option for which the value was given.
+ *
+ *      slot [in]
+ *          The slot holding the instances of the option.
+ *
+ *      value [in]
+ *          The value given for the option.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing, though std::invalid_argument will be thrown if the key is
+ *      empty and an exception will be thrown if the key was already given
+ *      and duplicate keys are an error.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      None.
  */
-template<> void Parser::GetOptionValues<long long>(
-                                        const std::string &option_name,
-                                        std::vector<long long> &option_values,
-                                        long long min,
-                                        long long max)
+void Parser::StoreMapEntry(const Option &option,
+                           OptionSlot &slot,
+                           const std::string_view value)
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> long long
-                     {
-                         return std::stoll(value);
-                     };
+    const std::size_t separator = value.find(option.key_separator);
+    const std::string_view key = value.substr(0, separator);
+    const std::string_view mapped = (separator == std::string_view::npos) ?
+                                        std::string_view{} :
+                                        value.substr(separator + 1);
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    if (key.empty()) throw std::invalid_argument("empty key");
+
+    if (!std::get<OptionMap>(slot.typed_values)
+             .Insert(key, mapped, option.duplicate_keys))
+    {
+        std::ostringstream oss;
+        oss << "Duplicate key given for \""
+            << option.name
+            << "\": "
+            << ErrorContext(key);
+        throw OptionsException(oss.str(), OptionsError::DuplicateKey);
+    }
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::StoreString()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will append the given value to the slot's strings (or,
+ *      if values are interned, the value's handle to the slot's handles),
+ *      unless the option deduplicates its values and the value (or, if
+ *      folding case, a value differing only in case) was already stored.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
+ *      option_index [in]
+ *          The index of the option for which the value was given.
  *
- *      option_values [out]
- *          The option values given for the requested option.
+ *      slot [in]
+ *          The slot holding the instances of the option.
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *      value [in]
+ *          The value given for the option.
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Parser::StoreString(std::size_t option_index,
+                         OptionSlot &slot,
+                         const std::string_view value)
+{
+    const Deduplicate deduplicate = options[option_index].deduplicate;
+    auto *interned =
+                std::get_if<std::vector<InternedValue>>(&slot.typed_values);
+
+    if (deduplicate != Deduplicate::None)
+    {
+        const bool fold = (deduplicate == Deduplicate::CaseFolded);
+        std::string_view key = value;
+
+        if (fold)
+        {
+            FoldCase(value, folded_value, ContainsNonASCII(value));
+            key = folded_value;
+        }
+
+        const bool unique = InsertUniqueValue(
+            slot,
+            KeyedHash(key),
+            interned ? interned->size() : slot.values.size(),
+            [&](std::size_t position)
+            {
+                const std::string_view stored =
+                    interned ? intern_table->View((*interned)[position]) :
+                               std::string_view(slot.values[position]);
+
+                if (!fold) return stored == key;
+
+                FoldCase(stored, folded_stored, ContainsNonASCII(stored));
+
+                return folded_stored == key;
+            });
+
+        if (!unique) return;
+    }
+
+    if (interned)
+    {
+        interned->push_back(intern_table->Intern(value));
+    }
+    else
+    {
+        slot.values.emplace_back(value);
+    }
+}
+
+/*
+ *  Parser::StoreChoice()
+ *
+ *  Description:
+ *      This function will append the index of the given choice to the
+ *      slot's choices, unless the option deduplicates its values and the
+ *      choice was already stored.
+ *
+ *  Parameters:
+ *      option_index [in]
+ *          The index of the option for which the value was given.
+ *
+ *      slot [in]
+ *          The slot holding the instances of the option.
+ *
+ *      choice [in]
+ *          The index of the choice given.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      Choices are matched case insensitively only if options are, so
+ *      both deduplication modes are the same for choices.
  */
-template<> void Parser::GetOptionValues<unsigned long long>(
-                                const std::string &option_name,
-                                std::vector<unsigned long long> &option_values,
-                                unsigned long long min,
-                                unsigned long long max)
+void Parser::StoreChoice(std::size_t option_index,
+                         OptionSlot &slot,
+                         std::uint32_t choice)
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> unsigned long long
-                     {
-                         return std::stoull(value);
-                     };
+    auto &choices = std::get<std::vector<std::uint32_t>>(slot.typed_values);
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    if (options[option_index].deduplicate != Deduplicate::None)
+    {
+        const bool unique = InsertUniqueValue(
+            slot,
+            KeyedHash(std::uint64_t(choice)),
+            choices.size(),
+            [&](std::size_t position) { return choices[position] == choice; });
+
+        if (!unique) return;
+    }
+
+    choices.push_back(choice);
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::InsertUniqueValue()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will look for a value having the given hash in the
+ *      slot's index of unique values and, if no equal value is found,
+ *      insert the given position into the index.  The index is an
+ *      open-addressing hash table (using linear probing) that is kept at
+ *      most half full.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
+ *      slot [in]
+ *          The slot holding the instances of the option.
  *
- *      option_values [out]
- *          The option values given for the requested option.
+ *      hash [in]
+ *          The hash of the value (in case-folded form, if folding case).
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *      position [in]
+ *          The position at which the value will be stored if it is unique,
+ *          which is the number of values already stored.
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *      equal [in]
+ *          A function that is given the position of a stored value having
+ *          the same hash and returns true if the values are equal.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      True if the value is unique and should be stored, false if an equal
+ *      value was already stored.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      The hash must be a KeyedHash(), so that values cannot be crafted to
+ *      select the same entries and make storing them take quadratic time.
  */
-template<> void Parser::GetOptionValues<float>(
-                                        const std::string &option_name,
-                                        std::vector<float> &option_values,
-                                        float min,
-                                        float max)
+template<typename Equal>
+bool Parser::InsertUniqueValue(OptionSlot &slot,
+                               std::uint64_t hash,
+                               std::size_t position,
+                               const Equal &equal)
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> float
-                     {
-                         return std::stof(value);
-                     };
+    std::vector<IndexedValue> &index = slot.value_index;
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    // Grow the index (to at least 16 entries) if it would be over half full
+    if (2 * (position + 1) > index.size())
+    {
+        std::vector<IndexedValue> entries;
+        entries.swap(index);
+        index.assign(entries.empty() ? 16 : 2 * entries.size(),
+                     IndexedValue{0, 0});
+
+        const std::size_t mask = index.size() - 1;
+        for (const auto &entry : entries)
+        {
+            if (entry.position == 0) continue;
+
+            std::size_t i = entry.hash & mask;
+            while (index[i].position != 0) i = (i + 1) & mask;
+            index[i] = entry;
+        }
+    }
+
+    // Probe for an equal value, stopping at the first empty entry
+    const std::size_t mask = index.size() - 1;
+    std::size_t i = hash & mask;
+    while (index[i].position != 0)
+    {
+        if ((index[i].hash == hash) && equal(index[i].position - 1))
+        {
+            return false;
+        }
+        i = (i + 1) & mask;
+    }
+
+    index[i] = IndexedValue{hash, static_cast<std::uint32_t>(position + 1)};
+
+    return true;
 }
 
 /*
- *  Parser::GetOptionValues()
+ *  Parser::StoresStrings()
  *
  *  Description:
- *      This function will return the option values associated with a program
- *      option for which an argument is required.  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will determine whether the values given for the option
+ *      associated with the given slot are stored as strings.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which a value should be retrieved.
+ *      slot_index [in]
+ *          The index of the slot, which is the index of the option or, for
+ *          the final slot, refers to arguments not associated with an option.
  *
- *      option_values [out]
- *          The option values given for the requested option.
+ *  Returns:
+ *      True if values are stored as strings, false if the option does not
+ *      expect a value, is bound to a variable, or has a typed value.
  *
- *      min [in]
- *          The minimum allowed value for the option.  It defaults to the
- *          minumum value for the type.
+ *  Comments:
+ *      None.
+ */
+bool Parser::StoresStrings(std::size_t slot_index) const
+{
+    if (slot_index == options.size()) return true;
+
+    const Option &option = options[slot_index];
+
+    return option.parameter_expected && !option.binding &&
+           (option.value_type == ValueType::String) && option.choices.empty();
+}
+
+/*
+ *  Parser::InternsValues()
+ *
+ *  Description:
+ *      This function will determine whether the values given for the option
+ *      associated with the given slot are stored as handles to strings held
+ *      in the intern table.
+ *
+ *  Parameters:
+ *      slot_index [in]
+ *          The index of the slot, which is the index of the option or, for
+ *          the final slot, refers to arguments not associated with an option.
+ *
+ *  Returns:
+ *      True if an intern table is used and the option stores strings, false
+ *      otherwise.  Arguments not associated with an option are not interned.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Parser::InternsValues(std::size_t slot_index) const
+{
+    return intern_table && (slot_index < options.size()) &&
+           StoresStrings(slot_index);
+}
+
+/*
+ *  Parser::MatchChoice()
+ *
+ *  Description:
+ *      This function will find the choice of the given option that matches
+ *      the given value using the option's choice table.  The value is
+ *      hashed once to select a single entry of the table, so the time taken
+ *      does not depend on the number of choices.
+ *
+ *  Parameters:
+ *      option_index [in]
+ *          The index of the option for which the value was given.
+ *
+ *      value [in]
+ *          The value given for the option.
+ *
+ *  Returns:
+ *      The index of the matching choice, though an exception will be thrown
+ *      if the value does not match any choice.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint32_t Parser::MatchChoice(std::size_t option_index,
+                                  const std::string_view value)
+{
+    const ChoiceTable &table = choice_tables[option_index];
+    std::string_view key = value;
+
+    if (case_insensitive)
+    {
+        FoldCase(value, folded_choice, table.unicode_folding);
+        key = folded_choice;
+    }
+
+    Fingerprint fingerprint(table.seed);
+    fingerprint.Update(key);
+
+    const std::uint64_t hash = fingerprint.Value();
+    const std::uint32_t displacement =
+        table.displacements[ChoiceBucket(hash, table.bucket_mask)];
+    const std::uint32_t entry =
+        table.entries[DisplaceChoice(hash, displacement, table.mask)];
+
+    if ((entry == 0) || (table.names[entry - 1] != key))
+    {
+        const Option &option = options[option_index];
+        std::ostringstream oss;
+        oss << "Invalid choice for \""
+            << option.name
+            << "\": "
+            << ErrorContext(value)
+            << " [valid choices are ";
+        for (std::size_t i = 0; i < option.choices.size(); i++)
+        {
+            if (i > 0) oss << ", ";
+            oss << option.choices[i];
+        }
+        oss << "]";
+        throw OptionsException(oss.str(), OptionsError::InvalidChoice);
+    }
+
+    return entry - 1;
+}
+
+/*
+ *  Parser::ParseArguments()
+ *
+ *  Description:
+ *      This function will parse command-line arguments.
+ *
+ *  Parameters:
+ *      argc [in]
+ *          A count of the number of strings in the arv[] vector.  Note that
+ *          this is precisely the same argument as used in C/C++ code in the
+ *          main() function.  Thus, this must always be >= 1, since the first
+ *          element in argv[] is the name of the program.  If argc is < 1,
+ *          this function has no effect.
+ *
+ *      argv [in]
+ *          A vector of null-terminated strings that are parsed by this object.
+ *          The first element of the array is assumed to be the executable name
+ *          and will be ignored.
+ *
+ *  Returns:
+ *      Nothing, but if the user provides invalid input an exception will be
+ *      thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+void Parser::ParseArguments(const int argc, const char *const argv[])
+{
+    if (argc > 0)
+    {
+        ParseArguments(std::span(argv, static_cast<std::size_t>(argc)));
+    }
+}
+
+/*
+ *  Parser::ParseArguments()
+ *
+ *  Description:
+ *      This function will parse command-line arguments.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          A vector of user-provided program arguments.  This vector must
+ *          include the command name (or some string, even if empty) as the
+ *          first element of the vector to parallel the argv[] array.  The
+ *          first element of the vector is skipped over when parsing.
+ *
+ *  Returns:
+ *      Nothing, but if the user provides invalid input an exception will be
+ *      thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+void Parser::ParseArguments(const std::vector<std::string> &arguments)
+{
+    ParseArguments(std::span(arguments));
+}
+
+/*
+ *  Parser::ParseArguments()
+ *
+ *  Description:
+ *      This function will parse command-line arguments.
+ *
+ *  Parameters:
+ *      arguments [in]
+ *          A vector of user-provided program arguments.  This vector must
+ *          include the command name (or some string, even if empty) as the
+ *          first element of the vector to parallel the argv[] array.  The
+ *          first element of the vector is skipped over when parsing.
+ *
+ *  Returns:
+ *      Nothing, but if the user provides invalid input an exception will be
+ *      thrown.
+ *
+ *  Comments:
+ *      None.
+ */
+void Parser::ParseArguments(const std::vector<std::string_view> &arguments)
+{
+    ParseArguments(std::span(arguments));
+}
+
+/*
+ *  Parser::OptionGiven()
+ *
+ *  Description:
+ *      This function will return true if the specified option name was given
+ *      by the user or false it was not.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name to use to see if an option was given.
+ *
+ *  Returns:
+ *      True if the specified option was given by the user, false it it was not.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Parser::OptionGiven(const std::string &option_name) const
+{
+    return GetOptionCount(option_name) > 0;
+}
+
+/*
+ *  Parser::GetOptionCount()
+ *
+ *  Description:
+ *      This function will return a count of the number of times the specified
+ *      option was given.  The string represents the option name.  An empty
+ *      string refers to any command-line arguments that are not part
+ *      of the command-line options (e.g., a list of filenames or other
+ *      arguments given on the command-line).
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a count is desired.
+ *
+ *  Returns:
+ *      A count of the number of options having the specified option name
+ *      was parsed.  In the case of an empty string, it is a count of
+ *      the unaffiliated command-line option strings observed.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Parser::GetOptionCount(const std::string &option_name) const
+{
+    auto it = option_slot_index.find(option_name);
+
+    if (it == option_slot_index.end()) return 0;
+
+    return SlotCount(option_slots[(*it).second]);
+}
+
+/*
+ *  Parser::GetOptionHandle()
+ *
+ *  Description:
+ *      This function will return the handle of the specified option, which
+ *      is the index of the option within the Options given to the Parser.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which the handle is desired.
+ *
+ *  Returns:
+ *      The handle of the option, which may be used to index the bitset
+ *      returned by GetOptionPresence() and the counts returned by
+ *      GetOptionCounts().
+ *
+ *  Comments:
+ *      This function will throw an exception if there is no such option.
+ *      Arguments not associated with an option have no handle.
+ */
+std::size_t Parser::GetOptionHandle(const std::string &option_name) const
+{
+    auto it = option_slot_index.find(option_name);
+
+    if ((it == option_slot_index.end()) || ((*it).second == options.size()))
+    {
+        throw OptionsException(std::string("The option (\"") +
+                                   option_name +
+                                   std::string("\") is not defined"),
+                               OptionsError::UnknownOption);
+    }
+
+    return (*it).second;
+}
+
+/*
+ *  Parser::GetOptionMask()
+ *
+ *  Description:
+ *      This function will return a set holding the specified options, which
+ *      may be tested against the set of options given.
+ *
+ *  Parameters:
+ *      option_names [in]
+ *          The names of the options to include in the set.
+ *
+ *  Returns:
+ *      The set of the specified options.
+ *
+ *  Comments:
+ *      This function will throw an exception if any option is not defined.
+ *      A mask is intended to be computed once and tested after each parse.
+ */
+OptionPresence Parser::GetOptionMask(
+                            const std::vector<std::string> &option_names) const
+{
+    OptionPresence mask(options.size());
+
+    for (const auto &option_name : option_names)
+    {
+        mask.Set(GetOptionHandle(option_name));
+    }
+
+    return mask;
+}
+
+/*
+ *  Parser::GetOptionPresence()
+ *
+ *  Description:
+ *      This function will return the set of options given by the user.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A dense bitset having one bit per option, indexed by the option's
+ *      handle, which remains valid until options are cleared or arguments
+ *      are parsed again.
+ *
+ *  Comments:
+ *      The set may be copied into another set to retain a snapshot, which
+ *      does not allocate memory if the other set is of the same size.
+ */
+const OptionPresence &Parser::GetOptionPresence() const
+{
+    return presence;
+}
+
+/*
+ *  Parser::GetOptionCounts()
+ *
+ *  Description:
+ *      This function will return the number of times each option was given.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A span of counts having one element per option, indexed by the
+ *      option's handle, which remains valid until options are cleared or
+ *      arguments are parsed again.
+ *
+ *  Comments:
+ *      Arguments not associated with an option are not included, so one
+ *      should call GetOptionCount() with an empty string to count them.
+ */
+std::span<const std::size_t> Parser::GetOptionCounts() const
+{
+    return option_counts;
+}
+
+/*
+ *  Parser::GetOptionString()
+ *
+ *  Description:
+ *      This function will return the option string associated with a program
+ *      option for which an argument is required.  In the case of arguments not
+ *      associated with an option flag (e.g., a list of filenames or similar),
+ *      those arguments are stored under the option name "" (empty string).
+ *
+ *      For options that do not have arguments, one should use OptionGiven()
+ *      or GetOptionCount() to determine presence of the specified option.
+ *
+ *      If an option may be specified multiple times, one should call
+ *      GetOptionStrings() instead of this function.  This function will return
+ *      the argument string of only the first option string given if multiple
+ *      instances are allowed.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a count is desired.
+ *
+ *  Returns:
+ *      The string argument provided by the user for the given option name.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option was not
+ *      given by the user.  One should first check for existence of an option
+ *      by calling OptionGiven() or GetOptionCount().
+ */
+std::string Parser::GetOptionString(const std::string &option_name) const
+{
+    return std::string(GetOptionStringView(option_name));
+}
+
+/*
+ *  Parser::GetOptionStrings()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A vector of string arguments given by the user for the specified option
+ *      name.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  An exception is also
+ *      thrown if the option's values were converted when parsed (e.g., the
+ *      option has a value type or choices), since no strings are held.
+ */
+std::vector<std::string> Parser::GetOptionStrings(
+                                        const std::string &option_name) const
+{
+    const OptionSlot &slot = option_slots[FindStringSlot(option_name)];
+
+    // Interned values are copied from the intern table
+    if (const auto *interned =
+            std::get_if<std::vector<InternedValue>>(&slot.typed_values))
+    {
+        std::vector<std::string> strings;
+        strings.reserve(interned->size());
+        for (const auto handle : *interned)
+        {
+            strings.emplace_back(intern_table->View(handle));
+        }
+        return strings;
+    }
+
+    // Options that do not expect a value are presented as empty strings
+    if (slot.values.empty())
+    {
+        return std::vector<std::string>(slot.count);
+    }
+
+    return slot.values;
+}
+
+/*
+ *  Parser::GetOptionStringView()
+ *
+ *  Description:
+ *      This function will return a view of the option string associated with
+ *      a program option for which an argument is required.  This is the same
+ *      as GetOptionString(), except that the string is not copied.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which the value should be retrieved.
+ *
+ *  Returns:
+ *      A view of the string argument provided by the user for the given option
+ *      name.  The view remains valid until options are cleared, arguments are
+ *      parsed again, or the option strings are taken.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option was not
+ *      given by the user.  One should first check for existence of an option
+ *      by calling OptionGiven() or GetOptionCount().
+ */
+std::string_view Parser::GetOptionStringView(
+                                        const std::string &option_name) const
+{
+    const OptionSlot &slot = option_slots[FindStringSlot(option_name)];
+
+    // Interned values are viewed in the intern table
+    if (const auto *interned =
+            std::get_if<std::vector<InternedValue>>(&slot.typed_values))
+    {
+        return intern_table->View(interned->front());
+    }
+
+    // Options that do not expect a value are presented as an empty string
+    if (slot.values.empty()) return {};
+
+    return slot.values.front();
+}
+
+/*
+ *  Parser::GetOptionStringsView()
+ *
+ *  Description:
+ *      This function will return a view of the option values associated with
+ *      a program option for which an argument is required.  This is the same
+ *      as GetOptionStrings(), except that the strings are not copied.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the string arguments given by the user for the specified
+ *      option name.  The span remains valid until options are cleared,
+ *      arguments are parsed again, or the option strings are taken.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  Since no strings are
+ *      stored for options that do not expect a value, the span is empty for
+ *      such options, while an exception is thrown for options whose values
+ *      were converted when parsed.
+ */
+std::span<const std::string> Parser::GetOptionStringsView(
+                                        const std::string &option_name) const
+{
+    return FindOptionStrings(option_name);
+}
+
+/*
+ *  Parser::TakeOptionStrings()
+ *
+ *  Description:
+ *      This function will move the option values associated with a program
+ *      option out of the Parser, transferring ownership to the caller without
+ *      copying the strings.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be taken.
+ *
+ *  Returns:
+ *      A vector of string arguments given by the user for the specified option
+ *      name.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  Once the values are taken, the option is
+ *      treated as though it was not given.  Since the storage is transferred
+ *      to the caller, it is not reused when arguments are parsed again.
+ */
+std::vector<std::string> Parser::TakeOptionStrings(
+                                                const std::string &option_name)
+{
+    // Ensure the option was given and has string values
+    const std::size_t slot_index = FindStringSlot(option_name);
+    OptionSlot &slot = option_slots[slot_index];
+    std::vector<std::string> strings;
+
+    // Interned values are copied, as the table retains them
+    if (auto *interned =
+            std::get_if<std::vector<InternedValue>>(&slot.typed_values))
+    {
+        strings = GetOptionStrings(option_name);
+        interned->clear();
+    }
+    // Options that do not expect a value are only counted
+    else if (!slot.values.empty())
+    {
+        strings = std::exchange(slot.values, {});
+    }
+    else
+    {
+        strings.resize(slot.count);
+    }
+
+    slot.count = 0;
+    std::fill(slot.value_index.begin(),
+              slot.value_index.end(),
+              IndexedValue{0, 0});
+    if (slot_index < options.size())
+    {
+        presence.Reset(slot_index);
+        option_counts[slot_index] = 0;
+    }
+
+    return strings;
+}
+
+/*
+ *  Parser::GetOptionPositions()
+ *
+ *  Description:
+ *      This function will return the positions of the first and last
+ *      instances of the given option among the parsed arguments, where the
+ *      position is the index of the argument (e.g., within argv[]) that
+ *      specified the option.  For arguments not associated with an option
+ *      flag, which are stored under the option name "" (empty string), these
+ *      are the positions of the first and last such arguments.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which positions should be retrieved.
+ *
+ *  Returns:
+ *      A pair holding the positions of the first and last instances of the
+ *      given option.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().
+ */
+std::pair<std::size_t, std::size_t> Parser::GetOptionPositions(
+                                        const std::string &option_name) const
+{
+    const OptionSlot &slot = FindOptionSlot(option_name);
+
+    return {slot.first_position, slot.last_position};
+}
+
+/*
+ *  Parser::GetRemainderPosition()
+ *
+ *  Description:
+ *      This function will return the position of the first argument that was
+ *      not parsed because option parsing ended at a terminator or, if
+ *      options must come first, at an argument not associated with an
+ *      option.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The position of the first argument of the remainder (where the
+ *      command name is at position zero), which equals the number of
+ *      arguments if a terminator was the final argument, or an empty
+ *      optional if option parsing did not end early.
+ *
+ *  Comments:
+ *      GetRemainder() applies this position to the original arguments.
+ */
+std::optional<std::size_t> Parser::GetRemainderPosition() const
+{
+    if (remainder_position == 0) return {};
+
+    return remainder_position;
+}
+
+/*
+ *  Parser::GetUnknownPositions()
+ *
+ *  Description:
+ *      This function will return the positions of the arguments passed
+ *      through because they appear to be options, but match no option,
+ *      along with the positions of any values taken for them.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A span of positions in the order the arguments were given (where the
+ *      command name is at position zero), which remains valid until options
+ *      are cleared or arguments are parsed again.
+ *
+ *  Comments:
+ *      Positions refer to the original arguments, so arguments are forwarded
+ *      to another program without being copied (e.g., argv[position]).
+ */
+std::span<const std::size_t> Parser::GetUnknownPositions() const
+{
+    return unknown_positions;
+}
+
+/*
+ *  Parser::AppendOptions()
+ *
+ *  Description:
+ *      This function will append the options given on the command-line to
+ *      the given argument vector in canonical form, so that a command-line
+ *      for a child process may be formed from the options parsed.  Each
+ *      option is given using its long option (as "--name=value"), or its
+ *      short option (as "-n value") if it has no long option.  Options are
+ *      appended in the order first given, with every instance of an option
+ *      not expecting a value and every value of an option expecting one.
+ *
+ *  Parameters:
+ *      arguments [out]
+ *          The argument vector to which options are appended.
+ *
+ *      excluded [in]
+ *          Options not to append (e.g., from GetOptionMask()), such as those
+ *          the caller will replace or that the child does not accept.
+ *
+ *  Returns:
+ *      Nothing, though an exception will be thrown if an option bound to a
+ *      variable or having a map value was given and not excluded, since the
+ *      Parser does not hold its values.
+ *
+ *  Comments:
+ *      The values of a delimited list are joined into a single argument, as
+ *      are the intervals of an interval set.  Numeric values are formatted
+ *      in shortest form, so the text given may differ, though the child
+ *      will parse the same values.  Arguments not associated with an option
+ *      are not appended; a caller may append them following a terminator
+ *      using GetOptionStringsView("").  No memory is allocated beyond that
+ *      needed to grow the argument vector.
+ */
+void Parser::AppendOptions(ArgumentVector &arguments,
+                           const OptionPresence &excluded) const
+{
+    const auto is_excluded = [&](std::size_t option_index)
+    {
+        return (option_index / 64 < excluded.Words().size()) &&
+               excluded.Test(option_index);
+    };
+
+    // Ensure that the values of every option may be formed before appending
+    for (const auto option_index : given_options)
+    {
+        const Option &option = options[option_index];
+
+        if (is_excluded(option_index) || !option.parameter_expected) continue;
+
+        if (option.binding || (option.choices.empty() &&
+                               (option.value_type == ValueType::Map)))
+        {
+            std::ostringstream oss;
+            oss << "Option \""
+                << option.name
+                << "\" does not retain its values, so it must be excluded";
+            throw OptionsException(oss.str(),
+                                   OptionsError::ValueTypeMismatch);
+        }
+    }
+
+    // Storage used when formatting numeric values
+    std::array<char, 32> number{};
+    const auto format = [&](auto value)
+    {
+        const auto result =
+            std::to_chars(number.data(), number.data() + number.size(), value);
+
+        return std::string_view(number.data(), result.ptr - number.data());
+    };
+
+    for (const auto option_index : given_options)
+    {
+        if (is_excluded(option_index)) continue;
+
+        const Option &option = options[option_index];
+        const OptionSlot &slot = option_slots[option_index];
+
+        // Append each instance of an option not expecting a value
+        if (!option.parameter_expected)
+        {
+            for (std::size_t i = 0; i < slot.count; i++)
+            {
+                AppendOptionName(arguments, option);
+            }
+            continue;
+        }
+
+        // Append each value, joining the values of a delimited list
+        const auto append_values = [&](std::size_t count, const auto &text)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                if ((i > 0) && (option.value_delimiter != '\0'))
+                {
+                    arguments.Extend({&option.value_delimiter, 1});
+                    arguments.Extend(text(i));
+                }
+                else if (AppendOptionName(arguments, option))
+                {
+                    arguments.Extend(text(i));
+                }
+                else
+                {
+                    arguments.Append(text(i));
+                }
+            }
+        };
+
+        if (InternsValues(option_index))
+        {
+            const auto &values =
+                std::get<std::vector<InternedValue>>(slot.typed_values);
+            append_values(values.size(), [&](std::size_t i) {
+                return intern_table->View(values[i]);
+            });
+        }
+        else if (StoresStrings(option_index))
+        {
+            append_values(slot.values.size(), [&](std::size_t i) {
+                return std::string_view(slot.values[i]);
+            });
+        }
+        else if (!option.choices.empty())
+        {
+            const auto &values =
+                std::get<std::vector<std::uint32_t>>(slot.typed_values);
+            append_values(values.size(), [&](std::size_t i) {
+                return std::string_view(option.choices[values[i]]);
+            });
+        }
+        else if (option.value_type == ValueType::Boolean)
+        {
+            const auto &values = std::get<std::vector<bool>>(slot.typed_values);
+            append_values(values.size(), [&](std::size_t i) {
+                return std::string_view(values[i] ? "true" : "false");
+            });
+        }
+        else if (option.value_type == ValueType::IntervalSet)
+        {
+            const auto &intervals =
+                std::get<std::vector<Interval>>(slot.typed_values);
+            if (intervals.empty()) continue;
+
+            // The merged intervals are given as a single value
+            const bool inline_value = AppendOptionName(arguments, option);
+            for (std::size_t i = 0; i < intervals.size(); i++)
+            {
+                if ((i == 0) && !inline_value)
+                {
+                    arguments.Append(format(intervals[i].lower));
+                }
+                else
+                {
+                    if (i > 0) arguments.Extend(",");
+                    arguments.Extend(format(intervals[i].lower));
+                }
+                if (intervals[i].upper != intervals[i].lower)
+                {
+                    arguments.Extend("-");
+                    arguments.Extend(format(intervals[i].upper));
+                }
+            }
+        }
+        else
+        {
+            std::visit(
+                [&](const auto &values)
+                {
+                    using T = std::decay_t<decltype(values)>;
+                    if constexpr (std::is_same_v<T,
+                                                 std::vector<std::int64_t>> ||
+                                  std::is_same_v<T,
+                                                 std::vector<std::uint64_t>> ||
+                                  std::is_same_v<T, std::vector<double>>)
+                    {
+                        append_values(values.size(), [&](std::size_t i) {
+                            return format(values[i]);
+                        });
+                    }
+                },
+                slot.typed_values);
+        }
+    }
+}
+
+/*
+ *  Parser::GetOptionIntegers()
+ *
+ *  Description:
+ *      This function will return the values given for an option having the
+ *      value type ValueType::Integer, which were converted when parsed.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the values given by the user for the specified option.
+ *      The span remains valid until options are cleared or arguments are
+ *      parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option has a different type.
+ */
+std::span<const std::int64_t> Parser::GetOptionIntegers(
+                                        const std::string &option_name) const
+{
+    return FindTypedValues<std::int64_t>(option_name);
+}
+
+/*
+ *  Parser::GetOptionUnsignedIntegers()
+ *
+ *  Description:
+ *      This function will return the values given for an option having the
+ *      value type ValueType::Unsigned, which were converted when parsed.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the values given by the user for the specified option.
+ *      The span remains valid until options are cleared or arguments are
+ *      parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option has a different type.
+ */
+std::span<const std::uint64_t> Parser::GetOptionUnsignedIntegers(
+                                        const std::string &option_name) const
+{
+    return FindTypedValues<std::uint64_t>(option_name);
+}
+
+/*
+ *  Parser::GetOptionFloats()
+ *
+ *  Description:
+ *      This function will return the values given for an option having the
+ *      value type ValueType::Floating, which were converted when parsed.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the values given by the user for the specified option.
+ *      The span remains valid until options are cleared or arguments are
+ *      parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option has a different type.
+ */
+std::span<const double> Parser::GetOptionFloats(
+                                        const std::string &option_name) const
+{
+    return FindTypedValues<double>(option_name);
+}
+
+/*
+ *  Parser::GetOptionBooleans()
+ *
+ *  Description:
+ *      This function will return the values given for an option having the
+ *      value type ValueType::Boolean, which were converted when parsed.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A reference to the values given by the user for the specified option.
+ *      The reference remains valid until options are cleared or arguments
+ *      are parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option has a different type.
+ *      Since booleans are stored as packed bits, a reference to the vector
+ *      is returned rather than a span.
+ */
+const std::vector<bool> &Parser::GetOptionBooleans(
+                                        const std::string &option_name) const
+{
+    return FindTypedValues<bool>(option_name);
+}
+
+/*
+ *  Parser::GetOptionInternedValues()
+ *
+ *  Description:
+ *      This function will return the handles of the values given for an
+ *      option whose values are interned.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the handles of the values given by the user for the
+ *      specified option, which may be compared with handles returned by the
+ *      intern table.  The span remains valid until options are cleared or
+ *      arguments are parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if its values are not interned.
+ */
+std::span<const InternedValue> Parser::GetOptionInternedValues(
+                                        const std::string &option_name) const
+{
+    return FindTypedValues<InternedValue>(option_name);
+}
+
+/*
+ *  Parser::SetInternTable()
+ *
+ *  Description:
+ *      This function will set the intern table used to hold the values of
+ *      options that store strings.  Once set, such values are stored as
+ *      handles and each distinct value is held once in the table, which may
+ *      be shared by many parsers.
+ *
+ *  Parameters:
+ *      table [in]
+ *          The intern table to use, or nullptr to store values as strings.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Any parsed options are cleared.  Copies of this parser share the
+ *      table.
+ */
+void Parser::SetInternTable(std::shared_ptr<InternTable> table)
+{
+    intern_table = std::move(table);
+
+    // Rebuild storage for option values
+    BuildOptionIndex();
+}
+
+/*
+ *  Parser::GetInternTable()
+ *
+ *  Description:
+ *      This function will return the intern table used to hold the values
+ *      of options that store strings.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The intern table, or nullptr if values are stored as strings.
+ *
+ *  Comments:
+ *      None.
+ */
+std::shared_ptr<InternTable> Parser::GetInternTable() const
+{
+    return intern_table;
+}
+
+/*
+ *  Parser::GetOptionMap()
+ *
+ *  Description:
+ *      This function will return the key/value pairs given for an option
+ *      having the value type ValueType::Map.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A reference to the map holding the pairs given by the user for the
+ *      specified option.  The reference remains valid until options are
+ *      cleared or arguments are parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option has a different type.
+ */
+const OptionMap &Parser::GetOptionMap(const std::string &option_name) const
+{
+    const OptionSlot &slot = FindOptionSlot(option_name);
+    const auto *map = std::get_if<OptionMap>(&slot.typed_values);
+
+    if (map == nullptr)
+    {
+        throw OptionsException(std::string("The option (\"") +
+                                   option_name +
+                                   std::string("\") does not have values of "
+                                               "the requested type"),
+                               OptionsError::ValueTypeMismatch);
+    }
+
+    return *map;
+}
+
+/*
+ *  Parser::GetOptionChoices()
+ *
+ *  Description:
+ *      This function will return the indices of the choices given for an
+ *      option having choices, which were matched when parsed.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the indices (into the option's choices) of the values
+ *      given by the user for the specified option.  The span remains valid
+ *      until options are cleared or arguments are parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option does not have choices.
+ */
+std::span<const std::uint32_t> Parser::GetOptionChoices(
+                                        const std::string &option_name) const
+{
+    return FindTypedValues<std::uint32_t>(option_name);
+}
+
+/*
+ *  Parser::GetOptionChoice()
+ *
+ *  Description:
+ *      This function will return the index of the choice given for an option
+ *      having choices.  If the option may be given multiple times, the
+ *      choice given first is returned.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which the value should be retrieved.
+ *
+ *  Returns:
+ *      The index (into the option's choices) of the value given by the user
+ *      for the specified option.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option does not have choices.
+ */
+std::size_t Parser::GetOptionChoice(const std::string &option_name) const
+{
+    return FindTypedValues<std::uint32_t>(option_name).front();
+}
+
+/*
+ *  Parser::GetOptionIntervals()
+ *
+ *  Description:
+ *      This function will return the set of values given for an option
+ *      having the value type ValueType::IntervalSet, which is the union of
+ *      the values and ranges given in every instance of the option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A view of the sorted, merged intervals given by the user for the
+ *      specified option.  The view remains valid until options are cleared
+ *      or arguments are parsed again.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if the option has a different type.
+ */
+IntervalSet Parser::GetOptionIntervals(const std::string &option_name) const
+{
+    return IntervalSet(FindTypedValues<Interval>(option_name));
+}
+
+/*
+ *  Parser::GetSpecFingerprint()
+ *
+ *  Description:
+ *      This function will return a fingerprint of the option specification,
+ *      which includes the program options, option flags, option value
+ *      separator, and case sensitivity.  Parsers configured identically have
+ *      the same specification fingerprint.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The 64-bit specification fingerprint.
+ *
+ *  Comments:
+ *      The fingerprint is computed when the options are set.
+ */
+std::uint64_t Parser::GetSpecFingerprint() const
+{
+    return spec_fingerprint;
+}
+
+/*
+ *  Parser::GetFingerprint()
+ *
+ *  Description:
+ *      This function will return a fingerprint of the parsed results, being
+ *      the number of instances and values of each option given, combined
+ *      with the specification fingerprint.  The fingerprint is stable across
+ *      platforms and releases of this library, so it may be used as a cache
+ *      key or stored.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The 64-bit fingerprint of the parsed results.
+ *
+ *  Comments:
+ *      The positions of options are not included, so the relative order of
+ *      different options does not affect the fingerprint, while the order of
+ *      values given for the same option does.
+ */
+std::uint64_t Parser::GetFingerprint() const
+{
+    Fingerprint fingerprint(spec_fingerprint);
+
+    for (std::size_t i = 0; i < option_slots.size(); i++)
+    {
+        const OptionSlot &slot = option_slots[i];
+        const std::size_t count = SlotCount(slot);
+
+        if (count == 0) continue;
+
+        fingerprint.Update(i);
+        fingerprint.Update(count);
+
+        for (const auto &value : slot.values) fingerprint.Update(value);
+
+        VisitTypedValues(slot.typed_values,
+                         [&](const auto &values)
+                         {
+                             for (const auto value : values)
+                             {
+                                 if constexpr (std::is_same_v<
+                                                    decltype(value),
+                                                    const InternedValue>)
+                                 {
+                                     fingerprint.Update(
+                                        intern_table->View(value));
+                                 }
+                                 else if constexpr (std::is_same_v<
+                                                    decltype(value),
+                                                    const Interval>)
+                                 {
+                                     fingerprint.Update(value.lower);
+                                     fingerprint.Update(value.upper);
+                                 }
+                                 else if constexpr (std::is_floating_point_v<
+                                                            decltype(value)>)
+                                 {
+                                     fingerprint.Update(
+                                        std::bit_cast<std::uint64_t>(value));
+                                 }
+                                 else
+                                 {
+                                     fingerprint.Update(
+                                        static_cast<std::uint64_t>(value));
+                                 }
+                             }
+                         });
+
+        if (const auto *map = std::get_if<OptionMap>(&slot.typed_values))
+        {
+            map->ForEach(
+                [&fingerprint](std::string_view key, std::string_view value)
+                {
+                    fingerprint.Update(key);
+                    fingerprint.Update(value);
+                });
+        }
+    }
+
+    return fingerprint.Value();
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<short>(
+                                            const std::string &option_name,
+                                            std::vector<short> &option_values,
+                                            short min,
+                                            short max) const
+{
+    // Define the converter function
+    auto converter = [min, max](const std::string &value) -> short
+                     {
+                         int i = std::stoi(value);
+
+                         if ((i < min) || (i > max))
+                         {
+                             throw std::out_of_range("value out of range");
+                         }
+
+                         return static_cast<short>(i);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<unsigned short>(
+                                    const std::string &option_name,
+                                    std::vector<unsigned short> &option_values,
+                                    unsigned short min,
+                                    unsigned short max) const
+{
+    // Define the converter function
+    auto converter = [min, max](const std::string &value) -> unsigned short
+                     {
+                         int i = std::stoi(value);
+
+                         if ((i < min) || (i > max))
+                         {
+                             throw std::out_of_range("value out of range");
+                         }
+
+                         return static_cast<unsigned short>(i);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<int>(
+                                            const std::string &option_name,
+                                            std::vector<int> &option_values,
+                                            int min,
+                                            int max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> int
+                     {
+                         return std::stoi(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<unsigned>(
+                                        const std::string &option_name,
+                                        std::vector<unsigned> &option_values,
+                                        unsigned min,
+                                        unsigned max) const
+{
+    // Define the converter function
+    auto converter = [min, max](const std::string &value) -> unsigned
+                     {
+                         unsigned long i = std::stoul(value);
+
+                         if ((i < min) || (i > max))
+                         {
+                             throw std::out_of_range("value out of range");
+                         }
+
+                         return static_cast<unsigned>(i);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<long>(
+                                            const std::string &option_name,
+                                            std::vector<long> &option_values,
+                                            long min,
+                                            long max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> long
+                     {
+                         return std::stol(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<unsigned long>(
+                                    const std::string &option_name,
+                                    std::vector<unsigned long> &option_values,
+                                    unsigned long min,
+                                    unsigned long max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> unsigned long
+                     {
+                         return std::stoul(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<long long>(
+                                        const std::string &option_name,
+                                        std::vector<long long> &option_values,
+                                        long long min,
+                                        long long max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> long long
+                     {
+                         return std::stoll(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<unsigned long long>(
+                                const std::string &option_name,
+                                std::vector<unsigned long long> &option_values,
+                                unsigned long long min,
+                                unsigned long long max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> unsigned long long
+                     {
+                         return std::stoull(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<float>(
+                                        const std::string &option_name,
+                                        std::vector<float> &option_values,
+                                        float min,
+                                        float max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> float
+                     {
+                         return std::stof(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::GetOptionValues()
+ *
+ *  Description:
+ *      This function will return the option values associated with a program
+ *      option for which an argument is required.  For options that do not have
+ *      arguments, one should use OptionGiven() or GetOptionCount() to
+ *      determine presence of the specified option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which a value should be retrieved.
+ *
+ *      option_values [out]
+ *          The option values given for the requested option.
+ *
+ *      min [in]
+ *          The minimum allowed value for the option.  It defaults to the
+ *          minumum value for the type.
+ *
+ *      max [in]
+ *          The maximum allowed value for the option.  It defaults to the
+ *          maximum value for the type.
+ *
+ *  Returns:
+ *      Nothing, though the requested option values are placed in the
+ *      option_values parameter.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence
+ *      by calling OptionGiven() or GetOptionCount().  This function will also
+ *      throw an exception if there is an error converting the option string
+ *      value to numeric value.  Lastly, an exception will be thrown if the
+ *      value is not within the range min <= option_value <= max.
+ */
+template<> void Parser::GetOptionValues<double>(
+                                        const std::string &option_name,
+                                        std::vector<double> &option_values,
+                                        double min,
+                                        double max) const
+{
+    // Define the converter function
+    auto converter = [](const std::string &value) -> double
+                     {
+                         return std::stod(value);
+                     };
+
+    // Get each of the option values, applying the conversion function to each
+    GetOptionValues(option_name, converter, option_values, min, max);
+}
+
+/*
+ *  Parser::FindOptionSlot()
+ *
+ *  Description:
+ *      This function will return a reference to the slot holding the
+ *      instances of the given program option.  In the case of arguments not
+ *      associated with an option flag (e.g., a list of filenames or similar),
+ *      those arguments are stored under the option name "" (empty string).
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which the slot should be retrieved.
+ *
+ *  Returns:
+ *      A reference to the slot holding the instances of the specified option.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user.  One should first check for existence of
+ *      an option by calling OptionGiven() or GetOptionCount().
+ */
+const Parser::OptionSlot &Parser::FindOptionSlot(
+                                        const std::string &option_name) const
+{
+    auto it = option_slot_index.find(option_name);
+
+    if ((it == option_slot_index.end()) ||
+        (SlotCount(option_slots[(*it).second]) == 0))
+    {
+        throw OptionsException(std::string("The option (\"") +
+                                   option_name +
+                                   std::string("\") was not given"),
+                               OptionsError::OptionNotGiven);
+    }
+
+    return option_slots[(*it).second];
+}
+
+/*
+ *  Parser::FindStringSlot()
+ *
+ *  Description:
+ *      This function will return the index of the slot holding the instances
+ *      of the given program option, ensuring that the option's values (if
+ *      it expects any) are stored as strings.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which the slot should be retrieved.
+ *
+ *  Returns:
+ *      The index of the slot holding the instances of the specified option.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option was not
+ *      given by the user or if its values were converted when parsed (i.e.,
+ *      it has a value type other than ValueType::String, has choices, or is
+ *      bound to a variable), since no strings are held for such an option.
+ *      Options that do not expect a value are only counted.
+ */
+std::size_t Parser::FindStringSlot(const std::string &option_name) const
+{
+    // Ensure the option was given, throwing an exception if not
+    FindOptionSlot(option_name);
+
+    const std::size_t slot_index = option_slot_index.find(option_name)->second;
+
+    if ((slot_index < options.size()) &&
+        options[slot_index].parameter_expected && !StoresStrings(slot_index))
+    {
+        throw OptionsException(std::string("The option (\"") +
+                                   option_name +
+                                   std::string("\") does not have string "
+                                               "values"),
+                               OptionsError::ValueTypeMismatch);
+    }
+
+    return slot_index;
+}
+
+/*
+ *  Parser::FindTypedValues()
+ *
+ *  Description:
+ *      This function will return the typed values of type T stored for the
+ *      given program option.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A reference to the vector holding the values.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if values of type T are not stored for
+ *      the option.
+ */
+template<typename T>
+const std::vector<T> &Parser::FindTypedValues(
+                                        const std::string &option_name) const
+{
+    const OptionSlot &slot = FindOptionSlot(option_name);
+    const auto *values = std::get_if<std::vector<T>>(&slot.typed_values);
+
+    if (values == nullptr)
+    {
+        throw OptionsException(std::string("The option (\"") +
+                                   option_name +
+                                   std::string("\") does not have values of "
+                                               "the requested type"),
+                               OptionsError::ValueTypeMismatch);
+    }
+
+    return *values;
+}
+
+/*
+ *  Parser::FindOptionStrings()
+ *
+ *  Description:
+ *      This function will return a view of the option values associated with
+ *      a program option.  In the case of arguments not associated with an
+ *      option flag (e.g., a list of filenames or similar), those arguments
+ *      are stored under the option name "" (empty string).  Options that do
+ *      not expect a value are only counted, so no strings are returned.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *  Returns:
+ *      A span over the string arguments given by the user for the specified
+ *      option name.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      was not given by the user or if its values are interned.  One should
+ *      first check for existence of an option by calling OptionGiven() or
+ *      GetOptionCount().
+ */
+std::span<const std::string> Parser::FindOptionStrings(
+                                        const std::string &option_name) const
+{
+    const OptionSlot &slot = option_slots[FindStringSlot(option_name)];
+
+    // Interned values are not held as strings
+    if (std::holds_alternative<std::vector<InternedValue>>(slot.typed_values))
+    {
+        throw OptionsException(std::string("The option (\"") +
+                                   option_name +
+                                   std::string("\") has interned values"),
+                               OptionsError::ValueTypeMismatch);
+    }
+
+    return slot.values;
+}
+
+/*
+ *  Parser::CovertOptionValues()
+ *
+ *  Description:
+ *      This function will convert the given option string to an option
+ *      value of type T, converted via the given converter function.
+ *
+ *  Parameters:
+ *      option_name [in]
+ *          The option name for which values should be retrieved.
+ *
+ *      converter [in]
+ *          The function that will convert the string "option value" to
+ *          the specified type T.
+ *
+ *      option_values [out]
+ *          The value of the option once the converter function is applied.
+ *
+ *      min [in]
+ *          The minimum value for the option.
+ *
+ *      max [in]
+ *          The maximum value for the option.
+ *
+ *  Returns:
+ *      Nothing, but the converted value will be stored in the option_value
+ *      argument.
+ *
+ *  Comments:
+ *      This function will throw an exception if the requested option
+ *      cannot be converted properly.
+ */
+template<NumericType T, typename Func>
+void Parser::GetOptionValues(const std::string &option_name,
+                             const Func &converter,
+                             std::vector<T> &option_values,
+                             T min,
+                             T max) const
+{
+    const std::string unknown = "<unknown>";
+    const std::string *context = nullptr;
+    T option_value{};
+
+    // Values of options having a value type were converted when parsed, so
+    // convert those values to type T
+    const OptionSlot &slot = FindOptionSlot(option_name);
+    if (!std::holds_alternative<std::monostate>(slot.typed_values) &&
+        !std::holds_alternative<std::vector<InternedValue>>(slot.typed_values))
+    {
+        // Interval sets and maps do not have numeric values
+        if (std::holds_alternative<std::vector<Interval>>(slot.typed_values) ||
+            std::holds_alternative<OptionMap>(slot.typed_values))
+        {
+            throw OptionsException(std::string("The option (\"") +
+                                       option_name +
+                                       std::string("\") does not have "
+                                                   "numeric values"),
+                                   OptionsError::ValueTypeMismatch);
+        }
+
+        option_values.clear();
+
+        VisitNumericValues(
+            slot.typed_values,
+            [&](const auto &values)
+            {
+                using V = typename std::remove_cvref_t<
+                                            decltype(values)>::value_type;
+
+                for (const V value : values)
+                {
+                    try
+                    {
+                        option_values.push_back(
+                                        ConvertTypedValue(value, min, max));
+                    }
+                    catch (const std::invalid_argument &)
+                    {
+                        std::ostringstream oss;
+                        oss << "Invalid argument value for \""
+                            << option_name
+                            << "\": "
+                            << value;
+                        throw OptionsException(oss.str(),
+                                               OptionsError::OptionValueError);
+                    }
+                    catch (const std::out_of_range &)
+                    {
+                        std::ostringstream oss;
+                        oss << "Argument value for \""
+                            << option_name
+                            << "\" is out-of-range: "
+                            << value
+                            << " [valid range is "
+                            << min
+                            << " .. "
+                            << max
+                            << "]";
+                        throw OptionsException(oss.str(),
+                                               OptionsError::OptionValueError);
+                    }
+                }
+            });
+
+        return;
+    }
+
+    // Get the original option string values (copying interned values)
+    std::vector<std::string> interned_strings;
+    std::span<const std::string> options_strings;
+    if (std::holds_alternative<std::vector<InternedValue>>(slot.typed_values))
+    {
+        interned_strings = GetOptionStrings(option_name);
+        options_strings = interned_strings;
+    }
+    else
+    {
+        options_strings = FindOptionStrings(option_name);
+    }
+
+    // Ensure the output vector is empty
+    option_values.clear();
+
+    try
+    {
+        // Options that do not expect a value have no value to convert
+        if (options_strings.empty())
+        {
+            throw std::invalid_argument("option has no value");
+        }
+
+        // Now convert each string to a numeric value using the specified
+        // converter function and place it in the output vector
+        for (const auto &option_string : options_strings)
+        {
+            // Get a pointer to the option string for context
+            context = &option_string;
+
+            // Convert the option value
+            option_value = converter(option_string);
+
+            // Check the value to ensure is within range
+            if ((option_value < min) || (option_value > max))
+            {
+                // Clear the option value for security reasons
+                option_value = 0;
+
+                throw std::out_of_range("value out of range");
+            }
+
+            // Store the converted value
+            option_values.emplace_back(option_value);
+
+            // Clear the option value for security reasons
+            option_value = 0;
+        }
+    }
+    catch (const std::invalid_argument &)
+    {
+        std::ostringstream oss;
+        oss << "Invalid argument value for \""
+            << option_name
+            << "\": "
+            << ((context == nullptr) ? unknown : ErrorContext(*context));
+        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+    }
+    catch (const std::out_of_range &)
+    {
+        std::ostringstream oss;
+        oss << "Argument value for \""
+            << option_name
+            << "\" is out-of-range: "
+            << ((context == nullptr) ? unknown : ErrorContext(*context))
+            << " [valid range is "
+            << min
+            << " .. "
+            << max
+            << "]";
+        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+    }
+    catch (...)
+    {
+        std::ostringstream oss;
+        oss << "Unknown error converting argument \""
+            << option_name
+            << "\": "
+            << ((context == nullptr) ? unknown : ErrorContext(*context));
+        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+    }
+}
+
+/*
+ *  Parser::CheckOptionFlags()
+ *
+ *  Description:
+ *      This function will look through the long and short flag vectors to
+ *      ensure there are no conflicts (e.g., both vectors having the same
+ *      string values).
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing, but will throw an exception if a flag conflict is found.
+ *
+ *  Comments:
+ *      None.
+ */
+void Parser::CheckOptionFlags()
+{
+    // Ensure the same flag was not specified for both long and short flags
+    for (const auto &long_flag : long_flags)
+    {
+        for (const auto &short_flag : short_flags)
+        {
+            if (long_flag == short_flag)
+            {
+                throw SpecificationException("Conflicting option flag symbols",
+                                             OptionsError::FlagConflict);
+            }
+        }
+    }
+}
+
+/*
+ *  Parser::CheckOptions()
+ *
+ *  Description:
+ *      This function will look through the Options given via the constructor
+ *      or SetOptions to check for errors.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Parser::CheckOptions()
+{
+    std::unordered_map<std::string, bool> identifiers;
+    std::unordered_map<std::string, bool> short_options;
+    std::unordered_map<std::string, bool> long_options;
+
+    // Note option identifiers found
+    for (const auto &option : options)
+    {
+        if (option.name.empty())
+        {
+            throw SpecificationException("Empty option identifier found",
+                                         OptionsError::EmptyIdentifierName);
+        }
+
+        // Ensure we have not seen this name before
+        if (identifiers.find(option.name) != identifiers.end())
+        {
+            std::string error = "Duplicate option identifier found: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::DuplicateIdentifier);
+        }
+        identifiers[option.name] = true;
+
+        // Ensure we have not seen this short option before (if specified)
+        if (!option.short_option.empty())
+        {
+            if (short_options.find(option.short_option) != short_options.end())
+            {
+                std::string error = "Duplicate short option observed: ";
+                throw SpecificationException(
+                                        error + option.short_option,
+                                        OptionsError::DuplicateShortOption);
+            }
+            if (option.short_option.length() > 1)
+            {
+                std::string error = "A short option contains more than one "
+                                    "character: ";
+                throw SpecificationException(error + option.short_option,
+                                             OptionsError::InvalidShortOption);
+            }
+            short_options[option.short_option] = true;
+        }
+
+        // Ensure we have not seen this long option before (if specified)
+        if (!option.long_option.empty())
+        {
+            if (long_options.find(option.long_option) != long_options.end())
+            {
+                std::string error = "Duplicate long option observed: ";
+                throw SpecificationException(error + option.long_option,
+                                             OptionsError::DuplicateLongOption);
+            }
+            long_options[option.long_option] = true;
+        }
+
+        // Ensure a bound variable can hold the number of times an option
+        // that does not expect a value was given
+        if (option.binding && !option.parameter_expected &&
+            !option.binding->AcceptsCount())
+        {
+            std::string error = "Option without a value must be bound to a "
+                                "bool or integral variable: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::InvalidBinding);
+        }
+
+        // Ensure typed values are only declared for options expecting a
+        // value and that the range of values is not empty
+        if (option.value_type != ValueType::String)
+        {
+            const ValueRange &range = option.value_range;
+
+            if (!option.parameter_expected)
+            {
+                std::string error = "A value type is given for an option "
+                                    "that does not expect a value: ";
+                throw SpecificationException(error + option.name,
+                                             OptionsError::InvalidValueType);
+            }
+            if ((range.integer_min > range.integer_max) ||
+                (range.unsigned_min > range.unsigned_max) ||
+                !(range.floating_min <= range.floating_max))
+            {
+                std::string error = "The range of values is empty: ";
+                throw SpecificationException(error + option.name,
+                                             OptionsError::InvalidValueType);
+            }
+        }
+
+        // Ensure choices are only given for options expecting a value that
+        // have no other value type and that each choice is distinct
+        if (!option.choices.empty())
+        {
+            if (!option.parameter_expected ||
+                (option.value_type != ValueType::String))
+            {
+                std::string error = "Choices are given for an option that "
+                                    "does not expect a string value: ";
+                throw SpecificationException(error + option.name,
+                                             OptionsError::InvalidValueType);
+            }
+
+            std::unordered_map<std::string, bool> choices;
+            for (const auto &choice : option.choices)
+            {
+                std::string key = case_insensitive ? FoldCase(choice, true)
+                                                   : choice;
+                if (choices.find(key) != choices.end())
+                {
+                    std::string error = "Duplicate choice for option " +
+                                        option.name + ": ";
+                    throw SpecificationException(
+                                        error + choice,
+                                        OptionsError::InvalidValueType);
+                }
+                choices[key] = true;
+            }
+        }
+
+        // Ensure values are only deduplicated for options storing strings
+        // or choices
+        if ((option.deduplicate != Deduplicate::None) &&
+            (!option.parameter_expected || option.binding ||
+             (option.value_type != ValueType::String)))
+        {
+            std::string error = "Values cannot be deduplicated for option: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::InvalidValueType);
+        }
+
+        // Ensure a map option has a key separator
+        if ((option.value_type == ValueType::Map) &&
+            (option.key_separator == '\0'))
+        {
+            std::string error = "A map option has no key separator: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::InvalidValueType);
+        }
+
+        // Ensure a value delimiter is only given for options expecting a
+        // value
+        if ((option.value_delimiter != '\0') && !option.parameter_expected)
+        {
+            std::string error = "A value delimiter is given for an option "
+                                "that does not expect a value: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::InvalidValueType);
+        }
+
+        // Ensure an interval set option does not name a delimiter other
+        // than the comma separating its intervals
+        if ((option.value_type == ValueType::IntervalSet) &&
+            (option.value_delimiter != '\0') &&
+            (option.value_delimiter != ','))
+        {
+            std::string error = "Intervals are delimited by commas, but "
+                                "another delimiter is given: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::InvalidValueType);
+        }
+
+        // Ensure a variable bound to choices is given for an option having
+        // choices
+        if (option.binding && option.binding->RequiresChoices() &&
+            option.choices.empty())
+        {
+            std::string error = "Option bound to a choice has no choices: ";
+            throw SpecificationException(error + option.name,
+                                         OptionsError::InvalidBinding);
+        }
+    }
+}
+
+/*
+ *  Parser::CheckConstraints()
  *
- *      max [in]
- *          The maximum allowed value for the option.  It defaults to the
- *          maximum value for the type.
+ *  Description:
+ *      This function will check the constraints among options against the
+ *      bitset of options given.  All Required constraints are checked
+ *      together with one comparison per word, and each Exclusive or Requires
+ *      constraint is checked using one or two word operations per word.
+ *
+ *  Parameters:
+ *      None.
  *
  *  Returns:
- *      Nothing, though the requested option values are placed in the
- *      option_values parameter.
+ *      Nothing, though a ConstraintException is thrown if a constraint is
+ *      not satisfied.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence
- *      by calling OptionGiven() or GetOptionCount().  This function will also
- *      throw an exception if there is an error converting the option string
- *      value to numeric value.  Lastly, an exception will be thrown if the
- *      value is not within the range min <= option_value <= max.
+ *      Required constraints are checked first, followed by the others in
+ *      the order given.  No memory is allocated unless a constraint is not
+ *      satisfied.
  */
-template<> void Parser::GetOptionValues<double>(
-                                        const std::string &option_name,
-                                        std::vector<double> &option_values,
-                                        double min,
-                                        double max)
+void Parser::CheckConstraints() const
 {
-    // Define the converter function
-    auto converter = [](const std::string &value) -> double
-                     {
-                         return std::stod(value);
-                     };
+    const std::span<const std::uint64_t> given = presence.Words();
 
-    // Get each of the option values, applying the conversion function to each
-    GetOptionValues(option_name, converter, option_values, min, max);
+    // Check that every required option was given
+    if (!presence.All(required_mask))
+    {
+        for (std::size_t i = 0; i < constraints.size(); i++)
+        {
+            if (constraints[i].type != ConstraintType::Required) continue;
+
+            for (const auto &name : constraints[i].options)
+            {
+                if (!presence.Test(option_slot_index.find(name)->second))
+                {
+                    ThrowConstraintViolation(i);
+                }
+            }
+        }
+    }
+
+    for (const auto &compiled : compiled_constraints)
+    {
+        const std::uint64_t *mask =
+                                constraint_masks.data() + compiled.mask_offset;
+
+        if (compiled.type == ConstraintType::Exclusive)
+        {
+            int count = 0;
+            for (std::size_t i = 0; i < given.size(); i++)
+            {
+                count += std::popcount(given[i] & mask[i]);
+            }
+            if (count > 1) ThrowConstraintViolation(compiled.constraint_index);
+        }
+        else if (presence.Test(compiled.trigger))
+        {
+            for (std::size_t i = 0; i < given.size(); i++)
+            {
+                if ((given[i] & mask[i]) != mask[i])
+                {
+                    ThrowConstraintViolation(compiled.constraint_index);
+                }
+            }
+        }
+    }
 }
 
 /*
- *  Parser::FindOptionStrings()
+ *  Parser::ThrowConstraintViolation()
  *
  *  Description:
- *      This function will return a reference to the vector of option values
- *      associated with a program option for which an argument is required.
- *      In the case of arguments not associated with an option flag (e.g.,
- *      a list of filenames or similar), those arguments are stored under
- *      the option name "" (empty string).  For options that do not have
- *      arguments, one should use OptionGiven() or GetOptionCount() to
- *      determine presence of the specified option.
+ *      This function will throw an exception describing the violation of the
+ *      given constraint.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which values should be retrieved.
+ *      constraint_index [in]
+ *          The index of the constraint that is not satisfied.
  *
  *  Returns:
- *      A reference to the vector of string arguments given by the user for
- *      the specified option name.
+ *      Nothing, as this function always throws a ConstraintException.  The
+ *      exception holds the names of the options that were not given (for
+ *      Required or Requires constraints) or that were given together (for
+ *      Exclusive constraints).
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      was not given by the user.  One should first check for existence of
- *      an option by calling OptionGiven() or GetOptionCount().
+ *      None.
  */
-const std::vector<std::string> &Parser::FindOptionStrings(
-                                            const std::string &option_name)
+void Parser::ThrowConstraintViolation(std::size_t constraint_index) const
 {
-    auto it = option_map.find(option_name);
+    const Constraint &constraint = constraints[constraint_index];
+    const bool exclusive = (constraint.type == ConstraintType::Exclusive);
+    std::vector<std::string> option_names;
 
-    if (it == option_map.end())
+    // Note the options given (if exclusive) or not given (otherwise), other
+    // than the option triggering a Requires constraint
+    for (std::size_t i = 0; i < constraint.options.size(); i++)
     {
-        throw OptionsException(std::string("The option (\"") +
-                                   option_name +
-                                   std::string("\") was not given"),
-                               OptionsError::OptionNotGiven);
+        if ((constraint.type == ConstraintType::Requires) && (i == 0)) continue;
+
+        const std::string &name = constraint.options[i];
+        if (presence.Test(option_slot_index.find(name)->second) == exclusive)
+        {
+            option_names.push_back(name);
+        }
     }
 
-    return (*it).second;
+    std::ostringstream oss;
+    OptionsError options_error{};
+    switch (constraint.type)
+    {
+        case ConstraintType::Required:
+            oss << "Required option not given:";
+            options_error = OptionsError::MissingRequiredOption;
+            break;
+
+        case ConstraintType::Exclusive:
+            oss << "Options may not be given together:";
+            options_error = OptionsError::ConflictingOptions;
+            break;
+
+        default:
+            oss << "Option \""
+                << constraint.options.front()
+                << "\" requires option:";
+            options_error = OptionsError::MissingDependency;
+            break;
+    }
+    for (const auto &name : option_names) oss << " \"" << name << "\"";
+
+    throw ConstraintException(oss.str(),
+                              options_error,
+                              constraint_index,
+                              std::move(option_names));
 }
 
 /*
- *  Parser::CovertOptionValues()
+ *  Parser::BuildOptionIndex()
  *
  *  Description:
- *      This function will convert the given option string to an option
- *      value of type T, converted via the given converter function.
+ *      This function will build the data structures used to match arguments
+ *      against the program options.  Long option names are placed into a
+ *      trie (in case-folded form if options are case insensitive) and short
+ *      option characters are placed into a table indexed by the option
+ *      character.  This allows matching to be performed using plain byte
+ *      comparisons in time proportional to the length of the argument,
+ *      regardless of the number of options.  The choices of each option are
+ *      compiled into a perfect hash table and the specification fingerprint
+ *      is also computed.
  *
  *  Parameters:
- *      option_name [in]
- *          The option name for which values should be retrieved.
- *
- *      converter [in]
- *          The function that will convert the string "option value" to
- *          the specified type T.
- *
- *      option_values [out]
- *          The value of the option once the converter function is applied.
- *
- *      min [in]
- *          The minimum value for the option.
- *
- *      max [in]
- *          The maximum value for the option.
+ *      None.
  *
  *  Returns:
- *      Nothing, but the converted value will be stored in the option_value
- *      argument.
+ *      Nothing.
  *
  *  Comments:
- *      This function will throw an exception if the requested option
- *      cannot be converted properly.
+ *      If more than one option uses the same short option character or long
+ *      option name, the first such option in the options vector is used.
  */
-template<NumericType T, typename Func>
-void Parser::GetOptionValues(const std::string &option_name,
-                             const Func &converter,
-                             std::vector<T> &option_values,
-                             T min,
-                             T max)
+void Parser::BuildOptionIndex()
 {
-    const std::string unknown = "<unknown>";
-    const std::string *context = nullptr;
-    T option_value{};
+    // Non-ASCII characters are only folded if some option name requires it
+    unicode_folding = false;
+    if (case_insensitive)
+    {
+        for (const auto &option : options)
+        {
+            if (ContainsNonASCII(option.long_option))
+            {
+                unicode_folding = true;
+                break;
+            }
+        }
+    }
 
-    // Get the original option string values
-    const std::vector<std::string> &options_strings =
-                                                FindOptionStrings(option_name);
+    // Build a trie of the (case-folded) long option names, with each node
+    // holding a map of child nodes keyed by the next character
+    struct TrieNode
+    {
+        std::size_t option_index;
+        std::map<unsigned char, std::uint32_t> children;
+    };
+    std::vector<TrieNode> trie(1, TrieNode{No_Option_Index, {}});
+    std::string key;
+    for (std::size_t i = 0; i < options.size(); i++)
+    {
+        if (options[i].long_option.empty()) continue;
 
-    // Ensure the output vector is empty
-    option_values.clear();
+        if (case_insensitive)
+        {
+            FoldCase(options[i].long_option, key, unicode_folding);
+        }
+        else
+        {
+            key = options[i].long_option;
+        }
 
-    try
+        std::uint32_t node = 0;
+        for (const char c : key)
+        {
+            const auto label = static_cast<unsigned char>(c);
+            auto it = trie[node].children.find(label);
+            if (it == trie[node].children.end())
+            {
+                trie.push_back(TrieNode{No_Option_Index, {}});
+                it = trie[node].children
+                         .emplace(label,
+                                  static_cast<std::uint32_t>(trie.size() - 1))
+                         .first;
+            }
+            node = it->second;
+        }
+
+        // If names collide, the first option in the options vector is used
+        if (trie[node].option_index == No_Option_Index)
+        {
+            trie[node].option_index = i;
+        }
+    }
+
+    // Flatten the trie so that the edges of each node are stored contiguously
+    // in sorted order, allowing edges to be found using a binary search
+    long_option_nodes.clear();
+    long_option_edge_labels.clear();
+    long_option_edge_targets.clear();
+    long_option_nodes.reserve(trie.size());
+    long_option_edge_labels.reserve(trie.size() - 1);
+    long_option_edge_targets.reserve(trie.size() - 1);
+    for (const auto &node : trie)
     {
-        // Now convert each string to a numeric value using the specified
-        // converter function and place it in the output vector
-        for (const auto &option_string : options_strings)
+        long_option_nodes.push_back(
+            {node.option_index,
+             static_cast<std::uint32_t>(long_option_edge_labels.size()),
+             static_cast<std::uint32_t>(node.children.size())});
+        for (const auto &[label, target] : node.children)
         {
-            // Get a pointer to the option string for context
-            context = &option_string;
+            long_option_edge_labels.push_back(static_cast<char>(label));
+            long_option_edge_targets.push_back(target);
+        }
+    }
 
-            // Convert the option value
-            option_value = converter(option_string);
+    // Create a slot for each option, plus one for non-option arguments
+    option_slot_index.clear();
+    option_slot_index.emplace("", options.size());
+    for (std::size_t i = 0; i < options.size(); i++)
+    {
+        if (options[i].name.empty()) continue;
 
-            // Check the value to ensure is within range
-            if ((option_value < min) || (option_value > max))
-            {
-                // Clear the option value for security reasons
-                option_value = 0;
+        option_slot_index.emplace(options[i].name, i);
+    }
+    option_slots.assign(options.size() + 1,
+                        OptionSlot{0, 0, 0, 0, 0, {}, {}, {}});
+    presence = OptionPresence(options.size());
+    option_counts.assign(options.size(), 0);
+    given_options.clear();
+    given_options.reserve(options.size());
+    remainder_position = 0;
+    unknown_positions.clear();
+
+    // Prepare storage for options having typed values
+    for (std::size_t i = 0; i < options.size(); i++)
+    {
+        if (!options[i].parameter_expected || options[i].binding) continue;
 
-                throw std::out_of_range("value out of range");
-            }
+        TypedValues &typed_values = option_slots[i].typed_values;
 
-            // Store the converted value
-            option_values.emplace_back(option_value);
+        if (!options[i].choices.empty())
+        {
+            typed_values.emplace<std::vector<std::uint32_t>>();
+            continue;
+        }
 
-            // Clear the option value for security reasons
-            option_value = 0;
+        if (InternsValues(i))
+        {
+            typed_values.emplace<std::vector<InternedValue>>();
+            continue;
+        }
+
+        switch (options[i].value_type)
+        {
+            case ValueType::Integer:
+                typed_values.emplace<std::vector<std::int64_t>>();
+                break;
+
+            case ValueType::Unsigned:
+                typed_values.emplace<std::vector<std::uint64_t>>();
+                break;
+
+            case ValueType::Floating:
+                typed_values.emplace<std::vector<double>>();
+                break;
+
+            case ValueType::Boolean:
+                typed_values.emplace<std::vector<bool>>();
+                break;
+
+            case ValueType::IntervalSet:
+                typed_values.emplace<std::vector<Interval>>();
+                break;
+
+            case ValueType::Map:
+                typed_values.emplace<OptionMap>();
+                break;
+
+            default:
+                break;
         }
     }
-    catch (const std::invalid_argument &)
+
+    // Populate the short option table
+    short_option_index.fill(No_Option_Index);
+    for (std::size_t i = 0; i < options.size(); i++)
     {
-        std::ostringstream oss;
-        oss << "Invalid argument value for \""
-            << option_name
-            << "\": "
-            << ((context == nullptr) ? unknown : *context);
-        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+        if (options[i].short_option.length() != 1) continue;
+
+        char c = options[i].short_option.front();
+
+        if (case_insensitive)
+        {
+            // Register both the lowercase and uppercase forms
+            c = FoldASCII(c);
+            if ((c >= 'a') && (c <= 'z'))
+            {
+                auto &upper = short_option_index[static_cast<unsigned char>(
+                                                                    c - 32)];
+                if (upper == No_Option_Index) upper = i;
+            }
+        }
+
+        auto &entry = short_option_index[static_cast<unsigned char>(c)];
+        if (entry == No_Option_Index) entry = i;
     }
-    catch (const std::out_of_range &)
+
+    // Compile the choices of each option into a perfect hash table
+    choice_tables.assign(options.size(), ChoiceTable{});
+    for (std::size_t i = 0; i < options.size(); i++)
     {
-        std::ostringstream oss;
-        oss << "Argument value for \""
-            << option_name
-            << "\" is out-of-range: "
-            << ((context == nullptr) ? unknown : *context)
-            << " [valid range is "
-            << min
-            << " .. "
-            << max
-            << "]";
-        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+        if (!options[i].choices.empty()) BuildChoiceTable(i);
     }
-    catch (...)
+
+    // Note the options bound to a variable
+    bound_options.clear();
+    for (std::size_t i = 0; i < options.size(); i++)
     {
-        std::ostringstream oss;
-        oss << "Unknown error converting argument \""
-            << option_name
-            << "\": "
-            << ((context == nullptr) ? unknown : *context);
-        throw OptionsException(oss.str(), OptionsError::OptionValueError);
+        if (options[i].binding) bound_options.push_back(i);
     }
+
+    // Compute the fingerprint of the specification
+    UpdateSpecFingerprint();
 }
 
 /*
- *  Parser::CheckOptionFlags()
+ *  Parser::UpdateSpecFingerprint()
  *
  *  Description:
- *      This function will look through the long and short flag vectors to
- *      ensure there are no conflicts (e.g., both vectors having the same
- *      string values).
+ *      This function will compute the fingerprint of the specification,
+ *      which covers the options, flags, and every setting that affects how
+ *      arguments are parsed.
  *
  *  Parameters:
  *      None.
  *
  *  Returns:
- *      Nothing, but will throw an exception if a flag conflict is found.
+ *      Nothing.
  *
  *  Comments:
- *      None.
+ *      Settings that do not change how options are matched or stored (e.g.,
+ *      terminators or constraints) call this function rather than
+ *      rebuilding the option index, so storage reserved via Reserve() is
+ *      retained.
  */
-void Parser::CheckOptionFlags()
+void Parser::UpdateSpecFingerprint()
 {
-    // Ensure the same flag was not specified for both long and short flags
-    for (const auto &long_flag : long_flags)
+    Fingerprint fingerprint;
+    fingerprint.Update(options.size());
+    for (const auto &option : options)
     {
-        for (const auto &short_flag : short_flags)
+        fingerprint.Update(option.name);
+        fingerprint.Update(option.short_option);
+        fingerprint.Update(option.long_option);
+        fingerprint.Update(std::uint64_t(option.multiple_allowed) |
+                           (std::uint64_t(option.parameter_expected) << 1) |
+                           (std::uint64_t(bool(option.binding)) << 2));
+        fingerprint.Update(static_cast<std::uint64_t>(option.value_type));
+        if (option.value_type != ValueType::String)
         {
-            if (long_flag == short_flag)
-            {
-                throw SpecificationException("Conflicting option flag symbols",
-                                             OptionsError::FlagConflict);
-            }
+            const ValueRange &range = option.value_range;
+            fingerprint.Update(static_cast<std::uint64_t>(range.integer_min));
+            fingerprint.Update(static_cast<std::uint64_t>(range.integer_max));
+            fingerprint.Update(range.unsigned_min);
+            fingerprint.Update(range.unsigned_max);
+            fingerprint.Update(
+                        std::bit_cast<std::uint64_t>(range.floating_min));
+            fingerprint.Update(
+                        std::bit_cast<std::uint64_t>(range.floating_max));
         }
+        fingerprint.Update(option.choices.size());
+        for (const auto &choice : option.choices) fingerprint.Update(choice);
+        fingerprint.Update(static_cast<std::uint64_t>(
+                        static_cast<unsigned char>(option.value_delimiter)));
+        fingerprint.Update(static_cast<std::uint64_t>(
+                        static_cast<unsigned char>(option.key_separator)));
+        fingerprint.Update(static_cast<std::uint64_t>(option.duplicate_keys));
+        fingerprint.Update(static_cast<std::uint64_t>(option.deduplicate));
+    }
+    fingerprint.Update(short_flags.size());
+    for (const auto &flag : short_flags) fingerprint.Update(flag);
+    fingerprint.Update(long_flags.size());
+    for (const auto &flag : long_flags) fingerprint.Update(flag);
+    fingerprint.Update(option_value_separator);
+    fingerprint.Update(std::uint64_t(case_insensitive));
+    fingerprint.Update(terminators.size());
+    for (const auto &terminator : terminators) fingerprint.Update(terminator);
+    fingerprint.Update(static_cast<std::uint64_t>(option_order));
+    fingerprint.Update(static_cast<std::uint64_t>(unknown_options));
+    fingerprint.Update(constraints.size());
+    for (const auto &constraint : constraints)
+    {
+        fingerprint.Update(static_cast<std::uint64_t>(constraint.type));
+        fingerprint.Update(constraint.options.size());
+        for (const auto &name : constraint.options) fingerprint.Update(name);
     }
+    spec_fingerprint = fingerprint.Value();
 }
 
 /*
- *  Parser::CheckOptions()
+ *  Parser::BuildChoiceTable()
  *
  *  Description:
- *      This function will look through the Options given via the constructor
- *      or SetOptions to check for errors.
+ *      This function will compile the choices of the given option into a
+ *      perfect hash table using hash and displace.  The choices are grouped
+ *      into buckets of about four choices by their fingerprint and, largest
+ *      bucket first, a displacement is found for each bucket that places
+ *      all of its choices in unused entries of the table.  The expected
+ *      time is linear in the number of choices.  Matching a value then
+ *      requires computing one fingerprint and one string comparison.
  *
  *  Parameters:
- *      None.
+ *      option_index [in]
+ *          The index of the option having choices.
  *
  *  Returns:
  *      Nothing.
  *
  *  Comments:
- *      None.
+ *      If an option lists the same choice more than once, the first is used.
+ *      Should a bucket not be placed, another fingerprint seed is tried.
  */
-void Parser::CheckOptions()
+void Parser::BuildChoiceTable(std::size_t option_index)
 {
-    std::unordered_map<std::string, bool> identifiers;
-    std::unordered_map<std::string, bool> short_options;
-    std::unordered_map<std::string, bool> long_options;
+    const std::vector<std::string> &choices = options[option_index].choices;
+    ChoiceTable &table = choice_tables[option_index];
 
-    // Note option identifiers found
-    for (const auto &option : options)
+    // Fold the choices if options are case insensitive
+    table.unicode_folding = false;
+    table.names.clear();
+    for (const auto &choice : choices)
+    {
+        if (case_insensitive)
+        {
+            if (ContainsNonASCII(choice)) table.unicode_folding = true;
+            table.names.push_back(FoldCase(choice, true));
+        }
+        else
+        {
+            table.names.push_back(choice);
+        }
+    }
+
+    // Use a table at least twice the number of choices, so that it is at
+    // most half full, and enough buckets for about four choices each
+    std::size_t size = 1;
+    while (size < 2 * choices.size()) size <<= 1;
+    std::size_t bucket_count = 1;
+    while (bucket_count * Choices_Per_Bucket < choices.size())
+    {
+        bucket_count <<= 1;
+    }
+    table.mask = size - 1;
+    table.bucket_mask = bucket_count - 1;
+
+    // Note choices repeating an earlier choice, which are not placed
+    std::vector<std::size_t> members(choices.size());
+    std::vector<bool> repeated(choices.size(), false);
+    for (std::size_t i = 0; i < choices.size(); i++) members[i] = i;
+    std::stable_sort(members.begin(),
+                     members.end(),
+                     [&](std::size_t a, std::size_t b)
+                     {
+                         return table.names[a] < table.names[b];
+                     });
+    for (std::size_t i = 1; i < members.size(); i++)
+    {
+        if (table.names[members[i]] == table.names[members[i - 1]])
+        {
+            repeated[members[i]] = true;
+        }
+    }
+
+    std::vector<std::uint64_t> hashes(choices.size());
+    std::vector<std::size_t> bucket_start(bucket_count + 1);
+    std::vector<std::size_t> bucket_end(bucket_count);
+    std::vector<std::size_t> bucket_order(bucket_count);
+    std::vector<std::size_t> positions;
+
+    for (table.seed = 0;; table.seed++)
     {
-        if (option.name.empty())
+        // Fingerprint the choices and group them by bucket, retaining the
+        // order of the choices within each bucket
+        std::fill(bucket_start.begin(), bucket_start.end(), 0);
+        for (std::size_t i = 0; i < choices.size(); i++)
         {
-            throw SpecificationException("Empty option identifier found",
-                                         OptionsError::EmptyIdentifierName);
-        }
+            if (repeated[i]) continue;
 
-        // Ensure we have not seen this name before
-        if (identifiers.find(option.name) != identifiers.end())
+            Fingerprint fingerprint(table.seed);
+            fingerprint.Update(table.names[i]);
+            hashes[i] = fingerprint.Value();
+            bucket_start[ChoiceBucket(hashes[i], table.bucket_mask) + 1]++;
+        }
+        for (std::size_t i = 0; i < bucket_count; i++)
         {
-            std::string error = "Duplicate option identifier found: ";
-            throw SpecificationException(error + option.name,
-                                         OptionsError::DuplicateIdentifier);
+            bucket_start[i + 1] += bucket_start[i];
+            bucket_end[i] = bucket_start[i];
         }
-        identifiers[option.name] = true;
+        for (std::size_t i = 0; i < choices.size(); i++)
+        {
+            if (repeated[i]) continue;
 
-        // Ensure we have not seen this short option before (if specified)
-        if (!option.short_option.empty())
+            members[bucket_end[ChoiceBucket(hashes[i], table.bucket_mask)]++] =
+                i;
+        }
+
+        // Place the largest buckets first, while the table is nearly empty
+        for (std::size_t i = 0; i < bucket_count; i++) bucket_order[i] = i;
+        std::stable_sort(bucket_order.begin(),
+                         bucket_order.end(),
+                         [&](std::size_t a, std::size_t b)
+                         {
+                             return (bucket_end[a] - bucket_start[a]) >
+                                    (bucket_end[b] - bucket_start[b]);
+                         });
+
+        table.entries.assign(size, 0);
+        table.displacements.assign(bucket_count, 0);
+
+        bool placed = true;
+        for (const auto bucket : bucket_order)
         {
-            if (short_options.find(option.short_option) != short_options.end())
+            if (bucket_start[bucket] == bucket_end[bucket]) break;
+
+            // Find a displacement placing each choice in an unused entry
+            bool fits = false;
+            std::uint32_t displacement = 0;
+            for (; !fits && (displacement < Displacement_Limit);
+                 displacement++)
             {
-                std::string error = "Duplicate short option observed: ";
-                throw SpecificationException(
-                                        error + option.short_option,
-                                        OptionsError::DuplicateShortOption);
+                fits = true;
+                positions.clear();
+                for (std::size_t j = bucket_start[bucket];
+                     fits && (j < bucket_end[bucket]);
+                     j++)
+                {
+                    const std::size_t position = DisplaceChoice(
+                                                        hashes[members[j]],
+                                                        displacement,
+                                                        table.mask);
+                    fits = (table.entries[position] == 0) &&
+                           (std::find(positions.begin(),
+                                      positions.end(),
+                                      position) == positions.end());
+                    positions.push_back(position);
+                }
             }
-            if (option.short_option.length() > 1)
+
+            if (!fits)
             {
-                std::string error = "A short option contains more than one "
-                                    "character: ";
-                throw SpecificationException(error + option.short_option,
-                                             OptionsError::InvalidShortOption);
+                placed = false;
+                break;
             }
-            short_options[option.short_option] = true;
-        }
 
-        // Ensure we have not seen this long option before (if specified)
-        if (!option.long_option.empty())
-        {
-            if (long_options.find(option.long_option) != long_options.end())
+            table.displacements[bucket] = displacement - 1;
+            for (std::size_t j = bucket_start[bucket]; j < bucket_end[bucket];
+                 j++)
             {
-                std::string error = "Duplicate long option observed: ";
-                throw SpecificationException(error + option.long_option,
-                                             OptionsError::DuplicateLongOption);
+                table.entries[positions[j - bucket_start[bucket]]] =
+                    static_cast<std::uint32_t>(members[j] + 1);
             }
-            long_options[option.long_option] = true;
         }
+
+        if (placed) break;
     }
 }
 
@@ -1226,538 +4290,454 @@ void Parser::CheckOptions()
 bool Parser::ProcessArgument(const std::string_view argument,
                              const std::optional<std::string_view> &parameter)
 {
-    // If the argument is zero-length, no point checking for options
-    if (!argument.empty())
+    // Match using the instantiation for the configured case sensitivity
+    if (case_insensitive)
     {
-        // Try to process the argument by considering long option formats first
-        auto [long_option_matched, long_parameter_consumed] =
-                                        ProcessLongOption(argument, parameter);
-
-        if (long_option_matched) return long_parameter_consumed;
-
-        // Try to process the argument by considering short option formats
-        auto [short_option_matched, short_parameter_consumed] =
-                                        ProcessShortOption(argument, parameter);
-
-        if (short_option_matched) return short_parameter_consumed;
+        return MatchArgument(RuntimePolicy<true>{short_flags,
+                                                 long_flags,
+                                                 option_value_separator},
+                             argument,
+                             parameter);
     }
 
-    // Since neither the long or short option was matched, the argument will
-    // be added to the list of strings
-    option_map[""].emplace_back(argument);
-
-    return false;
+    return MatchArgument(RuntimePolicy<false>{short_flags,
+                                              long_flags,
+                                              option_value_separator},
+                         argument,
+                         parameter);
 }
 
 /*
- *  Parser::ProcessLongOption()
+ *  Parser::StoreOption()
  *
  *  Description:
- *      This function consider the provided argument and determine if it is a
- *      long option argument.  If it is and the option consumes the provided
- *      additional parameter, that will be noted in the return value.  If it
- *      appears to be a long option based on flags, but it does not match any
- *      option, an exception will be thrown.  If it appears to match a long
- *      option flag and only the flags (e.g., "--"), it will be treated as a
- *      string and put into the option_map in the vector of strings under the
- *      key "".
+ *      This function will record an instance of the given option.  The
+ *      optional parameter is also stored if this option expects a parameter to
+ *      be provided; options that do not expect a parameter are only counted.
  *
  *  Parameters:
- *      argument [in]
- *          The argument to process.
+ *      option_index [in]
+ *          The index of the option to be stored.
  *
  *      parameter [in]
  *          A possible parameter for an argument that expect a parameter to
- *          follow.
+ *          follow.  This is an optional type since there may not actually be a
+ *          parameter to provide and the caller just provides something if it
+ *          has it.  This function determines whether the parameter is required
+ *          or not and will throw an exception if a required parameter is
+ *          missing.
  *
  *  Returns:
- *      A pair of bool values, the first being true if the argument was
- *      processed as a long option argument and false if it was not processed
- *      as a long option argument.  If processed, the second bool indicates
- *      whether the optional parameter was also consumed as a parameter to the
- *      option or if it should be separately considered.
+ *      Returns true if the parameter value was consumed (stored) or false if
+ *      it was not.
  *
  *  Comments:
  *      None.
  */
-std::pair<bool, bool> Parser::ProcessLongOption(
-                            const std::string_view argument,
-                            const std::optional<std::string_view> &parameter)
+bool Parser::StoreOption(std::size_t option_index,
+                         const std::optional<std::string_view> &parameter)
 {
-    // Iterator pointing to start of argument string
-    std::string_view::const_iterator argument_start_iterator{};
+    const Option &option = options[option_index];
 
-    // Iterator pointing to end of argument string
-    std::string_view::const_iterator argument_end_iterator{};
-
-    // Iterator pointing to start of a value string
-    std::string_view::const_iterator value_start_iterator{};
-
-    // Was an option matched?
-    bool matched_option = false;
+    // If only counting instances, errors are reported when storing
+    if (counting_pass)
+    {
+        std::size_t &pending = option_slots[option_index].pending;
 
-    // Indicate whether parameter was consumed
-    bool parameter_consumed = false;
+        // Count each value in a delimited list
+        if ((option.value_delimiter != '\0') && option.parameter_expected &&
+            parameter.has_value())
+        {
+            pending += static_cast<std::size_t>(std::count(
+                                                    parameter->begin(),
+                                                    parameter->end(),
+                                                    option.value_delimiter));
+        }
+        pending++;
 
-    // If the argument is an empty string, there is no long option
-    if (argument.empty()) return {false, false};
+        return option.parameter_expected && parameter.has_value();
+    }
 
-    // Point to the start of the argument
-    argument_start_iterator = argument.cbegin();
+    OptionSlot &slot = UseOptionSlot(option_index);
 
-    // Find the start of the option (beyond the options strings (e.g., "--")),
-    // returning if no flags found
-    if (!FindOptionStart(long_flags, argument_start_iterator, argument.cend()))
-    {
-        return {false, false};
-    }
+    // Indicates if the parameter was consumed
+    bool parameter_consumed = false;
 
-    // If there are no other characters in the argument, then we matched only
-    // flag characters (e.g., "--"); accept that as string by storing it in the
-    // option map and returning
-    if (argument_start_iterator == argument.cend())
+    // Throw an exception if this option was already given, but multiple
+    // instances are not allowed
+    if (!option.multiple_allowed && (slot.count > 0))
     {
-        option_map[""].emplace_back(argument);
-        return {true, false};
+        std::ostringstream oss;
+        oss << "Option \""
+            << option.name
+            << "\" given multiple times, but only allowed once";
+        throw OptionsException(oss.str(), OptionsError::MultipleInstances);
     }
 
-    // Iterate over the options specification trying to match long option values
-    for (const auto &option : options)
+    // Does the option have an expected parameter?
+    if (option.parameter_expected)
     {
-        // Count of option characters matched
-        unsigned option_characters_matched = 0;
-
-        // If no long option name was given, look at the next entry
-        if (option.long_option.empty()) continue;
-
-        // Try to match the option name
-        argument_end_iterator = argument_start_iterator;
-        for (const auto c : option.long_option)
+        // Does the parameter have a value?
+        if (!parameter)
         {
-            if ((c == *argument_end_iterator) ||
-                (case_insensitive &&
-                 ((std::toupper(c) == std::toupper(*argument_end_iterator)))))
-            {
-                option_characters_matched++;
-                if (++argument_end_iterator == argument.cend()) break;
-            }
-            else
-            {
-                break;
-            }
+            std::ostringstream oss;
+            oss << "Option \""
+                << option.name
+                << "\" is missing a required argument";
+            throw OptionsException(oss.str(),
+                                   OptionsError::MissingOptionArgument);
         }
 
-        // If we did not match all of the characters in the option name,
-        // continue
-        if (option_characters_matched < option.long_option.length()) continue;
-
-        // Did we precisely match the name?
-        if (argument_end_iterator == argument.cend())
+        // Store the parameter with this option, converting it if the option
+        // is bound to a variable or has a typed value (interval sets split
+        // their own comma-separated lists)
+        if ((option.value_delimiter != '\0') &&
+            (option.value_type != ValueType::IntervalSet))
         {
-            // Store the command line option, noting if parameter is consumed
-            parameter_consumed = StoreOption(option, parameter);
-
-            // Note the option was matched
-            matched_option = true;
-
-            break;
+            StoreListValues(option_index, slot, *parameter);
         }
-
-        // See if we can find a value parameter (e.g., "foo=bar")
-        value_start_iterator = argument_end_iterator;
-        if (FindStringStart(option_value_separator,
-                            value_start_iterator,
-                            argument.cend()))
+        else if (StoresStrings(option_index))
         {
-            // This option appears to have an argument, produce an error
-            // if it is not supposed to have one
-            if (!option.parameter_expected)
-            {
-                std::ostringstream oss;
-                oss << "Option \""
-                    << option.name
-                    << "\" should not have a parameter: "
-                    << std::string(value_start_iterator, argument.cend());
-                throw OptionsException(oss.str(),
-                                       OptionsError::MissingOptionArgument);
-            }
-
-            // If the command-line was "--foo=" (nothing following in the
-            // argument string), treat it as an error
-            if (value_start_iterator == argument.cend())
-            {
-                std::ostringstream oss;
-                oss << "Option \""
-                    << option.name
-                    << "\" appears to have been given an empty parameter: "
-                    << argument;
-                throw OptionsException(oss.str(),
-                                       OptionsError::MissingOptionArgument);
-            }
-
-            // This is a command-line option like "--foo=bar", so the
-            // parameter is the rest of the string
-            StoreOption(option,
-                        std::string(value_start_iterator, argument.cend()));
-
-            // Note the option was matched
-            matched_option = true;
-
-            break;
+            StoreString(option_index, slot, *parameter);
+        }
+        else
+        {
+            StoreConvertedValue(option_index, slot, *parameter);
         }
 
-        // If we get to this point, we must have matched something like
-        // "--foo", but there are more characters in the argument and they are
-        // not an option value (e.g., not "--foo=bar").  So this must be an
-        // incorrect match.  Perhaps the user provided "--foobar" as an option
-        // argument.  Continue looking for a better match.
+        parameter_consumed = true;
     }
 
-    // If we could not match an option, raise an exception
-    if (!matched_option)
+    // Count this instance of the option, noting its position
+    if (slot.count++ == 0)
     {
-        std::string error = "Invalid option specified: ";
-        throw OptionsException(error + std::string(argument),
-                               OptionsError::InvalidLongOption);
+        slot.first_position = argument_position;
+        presence.Set(option_index);
+        given_options.push_back(option_index);
     }
+    slot.last_position = argument_position;
+    option_counts[option_index] = slot.count;
 
-    return {true, parameter_consumed};
+    return parameter_consumed;
 }
 
 /*
- *  Parser::ProcessShortOption()
+ *  Parser::StoreListValues()
  *
  *  Description:
- *      This function consider the provided argument and determine if it is a
- *      short option argument.  If it is and the option consumes the provided
- *      additional parameter, that will be noted in the return value.  If it
- *      appears to be a short option based on flags, but it does not match any
- *      option, an exception will be thrown.  If it appears to match a short
- *      option flag and only the flags (e.g., "-"), it will be treated as a
- *      string and put into the option_map in the vector of strings under the
- *      key "".
+ *      This function will split a parameter given for an option having a
+ *      value delimiter into its values and store each value as if it were
+ *      given separately.  The values are views into the parameter, so they
+ *      are only copied if the option stores strings.
  *
  *  Parameters:
- *      argument [in]
- *          The argument to process.
+ *      option_index [in]
+ *          The index of the option for which the parameter was given.
+ *
+ *      slot [in]
+ *          The slot holding the instances of the option.
  *
  *      parameter [in]
- *          A possible parameter for an argument that expect a parameter to
- *          follow.
+ *          The parameter given for the option.
  *
  *  Returns:
- *      A pair of bool values, the first being true if the argument was
- *      processed as a short option argument and false if it was not processed
- *      as a short option argument.  If processed, the second bool indicates
- *      whether the optional parameter was also consumed as a parameter to the
- *      option or if it should be separately considered.
+ *      Nothing, though an exception will be thrown if any value is invalid.
+ *      The exception identifies the position of the value in the list.
  *
  *  Comments:
- *      None.
+ *      Empty values (e.g., between two delimiters) are stored as given.
  */
-std::pair<bool, bool> Parser::ProcessShortOption(
-                            const std::string_view argument,
-                            const std::optional<std::string_view> &parameter)
+void Parser::StoreListValues(std::size_t option_index,
+                             OptionSlot &slot,
+                             const std::string_view parameter)
 {
-    // Iterator over the argument string
-    std::string_view::const_iterator argument_iterator{};
-
-    // Indicate whether parameter was consumed
-    bool parameter_consumed = false;
+    const char delimiter = options[option_index].value_delimiter;
+    const bool stores_strings = StoresStrings(option_index);
+    const char *position = parameter.data();
+    const char *const end = parameter.data() + parameter.size();
+    std::size_t element = 0;
 
-    // If the argument is an empty string, there is no short option
-    if (argument.empty()) return {false, false};
-
-    // Point to the start of the argument
-    argument_iterator = argument.cbegin();
-
-    // Find the start of the option (beyond the options strings (e.g., "-")),
-    // returning if no flags found
-    if (!FindOptionStart(short_flags, argument_iterator, argument.cend()))
-    {
-        return {false, false};
-    }
-
-    // If there are no other characters in the argument, then we matched only
-    // flag characters (e.g., "-"); accept that as string by storing it in the
-    // option map and returning
-    if (argument_iterator == argument.cend())
-    {
-        option_map[""].emplace_back(argument);
-        return {true, false};
-    }
-
-    // Iterate over the characters in the option string
-    while (argument_iterator != argument.cend())
+    while (true)
     {
-        // Was an option matched?
-        bool matched_option = false;
-
-        // Get character pointed to by the iterator
-        std::string user_option = std::string() + *argument_iterator;
-        argument_iterator++;
-
-        // Iterate over the options to find a match
-        for (const auto &option : options)
+        // Find the end of this value using memchr(), which is typically
+        // vectorized by the C library
+        const auto *next = static_cast<const char *>(
+            std::memchr(position,
+                        delimiter,
+                        static_cast<std::size_t>(end - position)));
+        const std::string_view value(
+                    position,
+                    static_cast<std::size_t>((next ? next : end) - position));
+
+        if (stores_strings)
         {
-            // If no short option name was given, look at the next entry
-            if (option.short_option.empty()) continue;
-
-            // If we matched the name, process it
-            if ((option.short_option == user_option) ||
-                (case_insensitive &&
-                 ((Uppercase(option.short_option) == Uppercase(user_option)))))
+            StoreString(option_index, slot, value);
+        }
+        else
+        {
+            try
             {
-                // Store the value found
-                if (argument_iterator == argument.cend())
-                {
-                    // Store the command-line option, noting if parameter is
-                    // consumed
-                    parameter_consumed = StoreOption(option, parameter);
-                }
-                else
-                {
-                    // Store the command-line option, passing an empty optional
-                    // parameter
-                    StoreOption(option, {});
-                }
-
-                // We matched an option
-                matched_option = true;
-
-                break;
+                StoreConvertedValue(option_index, slot, value);
+            }
+            catch (const OptionsException &e)
+            {
+                std::ostringstream oss;
+                oss << e.what() << " (list element " << element + 1 << ")";
+                throw OptionsException(oss.str(), e.options_error);
             }
         }
 
-        // If we could not match an option, raise an exception
-        if (!matched_option)
-        {
-            std::string error = "Invalid option specified: ";
-            throw OptionsException(error + std::string(argument),
-                                   OptionsError::InvalidShortOption);
-        }
-    }
+        if (next == nullptr) break;
 
-    return {true, parameter_consumed};
+        position = next + 1;
+        element++;
+    }
 }
 
 /*
- *  Parser::StoreOption()
+ *  Parser::StoreOptionValue()
  *
  *  Description:
- *      This function will store the given option in the option map.  The
- *      optional parameter is also stored if this option expects a parameter to
- *      be provided.
+ *      This function will store an option for which the value was given as
+ *      part of the same argument (e.g., "--foo=bar").
  *
  *  Parameters:
- *      option [in]
- *          The option to be stored in the option map.
+ *      option_index [in]
+ *          The index of the option to be stored.
  *
- *      parameter [in]
- *          A possible parameter for an argument that expect a parameter to
- *          follow.  This is an optional type since there may not actually be a
- *          parameter to provide and the caller just provides something if it
- *          has it.  This function determines whether the parameter is required
- *          or not and will throw an exception if a required parameter is
- *          missing.
+ *      argument [in]
+ *          The entire argument, used for error reporting.
+ *
+ *      value [in]
+ *          The value following the option value separator.
  *
  *  Returns:
- *      Returns true if the parameter value was consumed (stored) or false if
- *      it was not.
+ *      Nothing, though an exception will be thrown if the option does not
+ *      expect a value or if the value is empty.
  *
  *  Comments:
  *      None.
  */
-bool Parser::StoreOption(const Option &option,
-                         const std::optional<std::string_view> &parameter)
+void Parser::StoreOptionValue(std::size_t option_index,
+                              const std::string_view argument,
+                              const std::string_view value)
 {
-    // Indicates if the parameter was consumed
-    bool parameter_consumed = false;
+    const Option &option = options[option_index];
 
-    // Throw an exception if this option is already in the option_map, but
-    // multiple instances are not allowed
-    if ((option_map.find(option.name) != option_map.end()) &&
-        !option.multiple_allowed)
+    // This option appears to have an argument, produce an error if it is not
+    // supposed to have one
+    if (!option.parameter_expected)
     {
         std::ostringstream oss;
         oss << "Option \""
             << option.name
-            << "\" given multiple times, but only allowed once";
-        throw OptionsException(oss.str(), OptionsError::MultipleInstances);
+            << "\" should not have a parameter: "
+            << ErrorContext(value);
+        throw OptionsException(oss.str(), OptionsError::MissingOptionArgument);
     }
 
-    // Does the option have an expected parameter?
-    if (!option.parameter_expected)
+    // If the command-line was "--foo=" (nothing following in the argument
+    // string), treat it as an error
+    if (value.empty())
     {
-        option_map[option.name].emplace_back("");
+        std::ostringstream oss;
+        oss << "Option \""
+            << option.name
+            << "\" appears to have been given an empty parameter: "
+            << ErrorContext(argument);
+        throw OptionsException(oss.str(), OptionsError::MissingOptionArgument);
     }
-    else
-    {
-        // Does the parameter have a value?
-        if (!parameter)
-        {
-            std::ostringstream oss;
-            oss << "Option \""
-                << option.name
-                << "\" is missing a required argument";
-            throw OptionsException(oss.str(),
-                                   OptionsError::MissingOptionArgument);
-        }
 
-        // Store the parameter with this option
-        option_map[option.name].emplace_back(*parameter);
+    StoreOption(option_index, value);
+}
 
-        parameter_consumed = true;
+/*
+ *  Parser::StoreArgument()
+ *
+ *  Description:
+ *      This function will store a command-line argument that is not
+ *      associated with an option under the option name "" (empty string).
+ *
+ *  Parameters:
+ *      argument [in]
+ *          The argument to store.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If options must be given first, the argument is not stored, but
+ *      instead begins the remainder of the arguments that are not parsed.
+ */
+void Parser::StoreArgument(const std::string_view argument)
+{
+    // If options must come first, this argument begins the remainder (in
+    // either pass, so the counting pass also stops here)
+    if (option_order == OptionOrder::OptionsFirst)
+    {
+        remainder_position = argument_position;
+        return;
     }
 
-    return parameter_consumed;
+    // If only counting instances, the argument is stored later
+    if (counting_pass)
+    {
+        option_slots.back().pending++;
+        return;
+    }
+
+    OptionSlot &slot = UseOptionSlot(option_slots.size() - 1);
+
+    slot.values.emplace_back(argument);
+
+    if (slot.count++ == 0) slot.first_position = argument_position;
+    slot.last_position = argument_position;
 }
 
 /*
- *  Parser::FindOptionStart()
+ *  Parser::StoreUnknownOption()
  *
  *  Description:
- *      This function will accept a vector of strings containing option flags
- *      (e.g., "--") and try to find the start of the argument beyond those
- *      flags.  It will accept a start an end iterator for a string that is
- *      used to compare with
- *      the vector of flag strings.
+ *      This function will record the position of the current argument, which
+ *      appears to be an option but matches no option, so that it may be
+ *      passed through.  If unknown options take values, the following
+ *      argument is also recorded as the option's value if it may be one.
  *
  *  Parameters:
- *      flags [in]
- *          Vector of option flags to evaluate.
- *
- *      argument_start_iterator [in/out]
- *          A string iterator pointing to the start of a command-line argument.
- *
- *      argument_end [in]
- *          A iterator pointing to the end of the string.
+ *      value_allowed [in]
+ *          True if the unknown option may take the following argument as
+ *          its value (i.e., it does not include a value and the following
+ *          argument exists and does not appear to be an option).
  *
  *  Returns:
- *      True if flags were found and false if no flags were found.  If the
- *      flags are true, the argument_start_iterator will be updated to point to
- *      the first character after the option flags (i.e., the actual argument
- *      name).
+ *      True if the following argument was taken as the option's value,
+ *      false otherwise.
  *
  *  Comments:
- *      None.
+ *      Nothing is recorded when only counting instances, but the same value
+ *      is returned so that both passes examine the same arguments.
  */
-bool Parser::FindOptionStart(
-                const std::vector<std::string> &flags,
-                std::string_view::const_iterator &argument_start_iterator,
-                const std::string_view::const_iterator &argument_end_iterator)
+bool Parser::StoreUnknownOption(bool value_allowed)
 {
-    // Saved copy of the start iterator
-    std::string_view::const_iterator argument_start_iterator_saved{};
+    const bool value_taken =
+        value_allowed &&
+        (unknown_options == UnknownOptions::PassThroughWithValues);
 
-    // If the start and end iterators equate, there is nothing to find
-    if (argument_start_iterator == argument_end_iterator) return false;
+    if (!counting_pass)
+    {
+        unknown_positions.push_back(argument_position);
+        if (value_taken) unknown_positions.push_back(argument_position + 1);
+    }
 
-    // Let's point to the start of the argument
-    argument_start_iterator_saved = argument_start_iterator;
+    return value_taken;
+}
 
-    // Consider each possible flag string (e.g., "--")
-    for (const auto &flag : flags)
+/*
+ *  Parser::AppendOptionName()
+ *
+ *  Description:
+ *      This function will append the given option to the argument vector in
+ *      canonical form, using the first long flag and the long option if the
+ *      option has one, or the first short flag and the short option.
+ *
+ *  Parameters:
+ *      arguments [out]
+ *          The argument vector to which the option is appended.
+ *
+ *      option [in]
+ *          The option to append.
+ *
+ *  Returns:
+ *      True if a value for the option should extend the appended argument
+ *      (as the option value separator was appended), or false if a value
+ *      should be appended as the following argument.
+ *
+ *  Comments:
+ *      The separator is appended only for options expecting a value.  The
+ *      flags and separator are those used when parsing, since a BasicParser
+ *      only permits those given by its policy.
+ */
+bool Parser::AppendOptionName(ArgumentVector &arguments,
+                              const Option &option) const
+{
+    if (!option.long_option.empty() && !long_flags.empty())
     {
-        // Let's point to the start of the argument
-        argument_start_iterator = argument_start_iterator_saved;
-
-        // See if we can find the flags at the start of the string
-        if (FindStringStart(flag,
-                            argument_start_iterator,
-                            argument_end_iterator))
+        if (option.parameter_expected && !option_value_separator.empty())
         {
+            arguments.Append({long_flags.front(),
+                              option.long_option,
+                              option_value_separator});
             return true;
         }
+
+        arguments.Append({long_flags.front(), option.long_option});
+        return false;
     }
 
+    arguments.Append({short_flags.front(), option.short_option});
+
     return false;
 }
 
 /*
- *  Parser::FindStringStart()
+ *  Parser::ThrowInvalidOption()
  *
  *  Description:
- *      This function will find the start of a string following a specified
- *      string prefix.  The string prefix might be option flags (e.g., "--") or
- *      an assignment character (e.g., "=").
+ *      This function will throw an exception indicating that the given
+ *      argument does not match any program option.
  *
  *  Parameters:
- *      prefix [in]
- *          A string prefix to skip over.
- *
- *      start_iterator [in/out]
- *          A string iterator pointing to the starting point to evaluate.
+ *      argument [in]
+ *          The argument that could not be matched.
  *
- *      end_iterator [in]
- *          An iterator pointing to the end of the string.
+ *      options_error [in]
+ *          The error type to report.
  *
  *  Returns:
- *      Returns true if the prefix was located, in which case the
- *      start_iterator will be set to the first character after the prefix
- *      characters.  If the prefix could not be found, false is returned.  Note
- *      that if no characters follow the prefix, the start_iterator will be
- *      equal to end_iterator on return of true.
+ *      This function does not return.
  *
  *  Comments:
  *      None.
  */
-bool Parser::FindStringStart(
-                        const std::string &prefix,
-                        std::string_view::const_iterator &start_iterator,
-                        const std::string_view::const_iterator &end_iterator)
+void Parser::ThrowInvalidOption(const std::string_view argument,
+                                OptionsError options_error)
 {
-    // Count of prefix characters matched
-    unsigned prefix_characters_matched = 0;
-
-    // If the start and end iterators equate, there is nothing to find
-    if (start_iterator == end_iterator) return false;
-
-    // Iterate over each character in the prefix
-    for (const auto c : prefix)
-    {
-        if (c == *start_iterator)
-        {
-            prefix_characters_matched++;
-            if (++start_iterator == end_iterator) break;
-        }
-        else
-        {
-            break;
-        }
-    }
-
-    // Did we match the entire prefix?
-    return (prefix.length() == prefix_characters_matched);
+    std::string error = "Invalid option specified: ";
+    throw OptionsException(error + ErrorContext(argument), options_error);
 }
 
 /*
- *  Parser::Uppercase()
+ *  Parser::ErrorContext()
  *
  *  Description:
- *      This function will return the uppercase version of a given string.
+ *      This function will return the given user input in a form suitable for
+ *      inclusion in an exception message.  Input longer than Max_Error_Context
+ *      octets is truncated and followed by "...", so the cost of producing an
+ *      error message does not depend on the size of the input.
  *
  *  Parameters:
- *      some_sting [in]
- *          Some string to convert to uppercase.
+ *      input [in]
+ *          The user input to quote in the error message.
  *
  *  Returns:
- *      Returns the uppercase transformation of a given string.
+ *      The (possibly truncated) input string.
  *
  *  Comments:
- *      None.
+ *      Truncation will not split a UTF-8 character sequence.
  */
-std::string Parser::Uppercase(std::string some_string)
+std::string Parser::ErrorContext(const std::string_view input)
 {
-    std::transform(some_string.begin(),
-                   some_string.end(),
-                   some_string.begin(),
-                   [](char c) -> char
-                   {
-                       return static_cast<char>(std::toupper(c));
-                   });
+    if (input.length() <= Max_Error_Context) return std::string(input);
+
+    // Back up to the start of a UTF-8 character if necessary
+    std::size_t length = Max_Error_Context;
+    while ((length > 0) &&
+           ((static_cast<unsigned char>(input[length]) & 0xC0) == 0x80))
+    {
+        length--;
+    }
 
-    return some_string;
+    return std::string(input.substr(0, length)) + "...";
 }
 
 } // namespace Terra::ProgramOptions
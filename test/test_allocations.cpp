@@ -0,0 +1,862 @@
+/*
+ *  test_allocations.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file will test the number of heap allocations performed by the
+ *      Program Options library.  The global operator new is replaced so that
+ *      every allocation is counted, allowing tests to assert how many
+ *      allocations a call to ParseArguments() or the GetOption*() functions
+ *      performs.  In particular, a Parser that is reused to parse similar
+ *      command-lines must not allocate any memory once it has reached a
+ *      steady state.
+ *
+ *      Note that option names are passed as std::string objects constructed
+ *      before counting begins, since constructing a long std::string from a
+ *      string literal may itself allocate memory.
+ *
+ *  Portability Issues:
+ *      The replacement aligned operator new obtains memory via
+ *      std::aligned_alloc(), which Visual C++ does not provide, so with that
+ *      compiler _aligned_malloc() is used instead and aligned memory is
+ *      released via _aligned_free().
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ranges>
+#include <span>
+#include <terra/program_options/program_options.h>
+#include <terra/program_options/basic_parser.h>
+#include <terra/program_options/option_binding.h>
+#include <terra/program_options/parser_pool.h>
+#include <terra/stf/stf.h>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace
+{
+
+// Count of allocations performed via operator new
+std::atomic<std::size_t> allocation_count{0};
+
+// Allocate memory, counting the allocation
+void *CountedAllocate(std::size_t size) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc((size == 0) ? 1 : size);
+}
+
+// Allocate aligned memory, counting the allocation
+void *CountedAllocate(std::size_t size, std::align_val_t alignment) noexcept
+{
+    const auto align = static_cast<std::size_t>(alignment);
+
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+#ifdef _MSC_VER
+    return _aligned_malloc((size == 0) ? 1 : size, align);
+#else
+    // The size must be a multiple of the alignment
+    size = ((size == 0 ? 1 : size) + align - 1) / align * align;
+
+    return std::aligned_alloc(align, size);
+#endif
+}
+
+// Release memory allocated with an alignment
+void AlignedFree(void *p) noexcept
+{
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+// Return the number of allocations performed when calling the function
+template<typename Function>
+std::size_t CountAllocations(const Function &function)
+{
+    const std::size_t start = allocation_count.load();
+
+    function();
+
+    return allocation_count.load() - start;
+}
+
+// clang-format off
+const Terra::ProgramOptions::Options Test_Options =
+{
+//    Name         Short  Long           Multi  Argument
+    { "all",         "a", "all",         false, false },
+    { "verbose",     "v", "verbose",     true,  false },
+    { "pattern",     "p", "pattern",     true,  true  },
+    { "color",       "c", "color",       false, true  },
+    { "size",        "s", "min-size",    false, true  },
+    { "level",       "l", "level",       true,  true  }
+};
+// clang-format on
+
+// Simulated command-line used in tests
+const char *Test_Arguments[] =
+{
+    "ls_type_program",
+    "-avvv",
+    "-p",
+    "foo",
+    "file1",
+    "--pattern=bar",
+    "--color",
+    "red",
+    "--min-size=20",
+    "-l",
+    "1",
+    "-l",
+    "2",
+    "--verbose",
+    "file2",
+    "-"
+};
+const int Test_Argument_Count =
+                    sizeof(Test_Arguments) / sizeof(Test_Arguments[0]);
+
+} // namespace
+
+// GCC may warn that free() is called on memory returned from operator new when
+// the replacement operator delete is inlined, but the replacement operator new
+// obtains memory via malloc()
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(std::size_t size)
+{
+    void *p = CountedAllocate(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size)
+{
+    void *p = CountedAllocate(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    void *p = CountedAllocate(size, alignment);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    void *p = CountedAllocate(size, alignment);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    AlignedFree(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+    AlignedFree(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    AlignedFree(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    AlignedFree(p);
+}
+
+// Ensure the allocation counter is working
+STF_TEST(Allocations, CounterWorks)
+{
+    std::size_t allocations = CountAllocations(
+        []()
+        {
+            // Call the function directly, as new expressions may be elided
+            void *p = ::operator new(16);
+            ::operator delete(p);
+        });
+
+    STF_ASSERT_EQ(std::size_t(1), allocations);
+}
+
+// A reused parser parses the argc/argv form without allocating
+STF_TEST(Allocations, ParseArgcArgvSteadyState)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+
+    // The first parse will allocate storage for the values
+    parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+
+    // Subsequent parses should reuse that storage
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        std::size_t allocations = CountAllocations(
+            [&]()
+            {
+                parser.ClearOptions();
+                parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+            });
+
+        STF_ASSERT_EQ(std::size_t(0), allocations);
+    }
+
+    // The results are still correct
+    STF_ASSERT_EQ(std::size_t(4), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+    STF_ASSERT_EQ(std::size_t(3), parser.GetOptionCount(""));
+}
+
+// A reused parser parses vectors of strings without allocating
+STF_TEST(Allocations, ParseVectorSteadyState)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const std::vector<std::string> strings(
+                                    Test_Arguments,
+                                    Test_Arguments + Test_Argument_Count);
+    const std::vector<std::string_view> views(
+                                    Test_Arguments,
+                                    Test_Arguments + Test_Argument_Count);
+
+    parser.ParseArguments(strings);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(strings);
+            parser.ClearOptions();
+            parser.ParseArguments(views);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+}
+
+// A reused case-insensitive parser parses without allocating
+STF_TEST(Allocations, ParseCaseInsensitiveSteadyState)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options,
+                                         {"-"},
+                                         {"--"},
+                                         "=",
+                                         true);
+    const std::vector<std::string> arguments =
+    {
+        "program",
+        "-AVVV",
+        "--PATTERN=some-long-pattern-value",
+        "--Min-Size=20",
+        "--VERBOSE"
+    };
+
+    parser.ParseArguments(arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(arguments);
+        });
+
+    // The long pattern value exceeds the small string buffer, so a single
+    // allocation is required to store it; matching itself allocates nothing
+    STF_ASSERT_EQ(std::size_t(1), allocations);
+    STF_ASSERT_EQ(std::size_t(4), parser.GetOptionCount("verbose"));
+}
+
+// A reused BasicParser parses without allocating
+STF_TEST(Allocations, ParseBasicParserSteadyState)
+{
+    Terra::ProgramOptions::BasicParser<> parser(Test_Options);
+
+    parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+}
+
+// Bundled short options do not allocate per character
+STF_TEST(Allocations, ShortOptionBundle)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const char *arguments[] = {"program", "-vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv"};
+
+    parser.ParseArguments(2, arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(2, arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(32), parser.GetOptionCount("verbose"));
+}
+
+// Count allocations performed by the query functions
+STF_TEST(Allocations, Queries)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const std::string verbose = "verbose";
+    const std::string pattern = "pattern";
+    const std::string color = "color";
+    const std::string level = "level";
+    std::string value;
+    std::vector<std::string> values;
+    std::vector<int> levels;
+
+    parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+    levels.reserve(2);
+
+    // Checking presence and counts does not allocate
+    STF_ASSERT_EQ(std::size_t(0),
+                  CountAllocations(
+                      [&]()
+                      {
+                          STF_ASSERT_TRUE(parser.OptionGiven(verbose));
+                          STF_ASSERT_EQ(std::size_t(4),
+                                        parser.GetOptionCount(verbose));
+                      }));
+
+    // Retrieving a short string does not allocate
+    STF_ASSERT_EQ(std::size_t(0),
+                  CountAllocations(
+                      [&]()
+                      {
+                          value = parser.GetOptionString(color);
+                      }));
+    STF_ASSERT_EQ(std::string("red"), value);
+
+    // Retrieving the strings copies the vector of values
+    STF_ASSERT_EQ(std::size_t(1),
+                  CountAllocations(
+                      [&]()
+                      {
+                          values = parser.GetOptionStrings(pattern);
+                      }));
+    STF_ASSERT_EQ(std::size_t(2), values.size());
+
+    // Viewing the strings does not allocate
+    std::string_view color_view;
+    std::span<const std::string> pattern_view;
+    STF_ASSERT_EQ(std::size_t(0),
+                  CountAllocations(
+                      [&]()
+                      {
+                          color_view = parser.GetOptionStringView(color);
+                          pattern_view = parser.GetOptionStringsView(pattern);
+                      }));
+    STF_ASSERT_EQ(std::string_view("red"), color_view);
+    STF_ASSERT_EQ(std::size_t(2), pattern_view.size());
+
+    // Converting values into a vector with sufficient capacity does not
+    // allocate
+    STF_ASSERT_EQ(std::size_t(0),
+                  CountAllocations(
+                      [&]()
+                      {
+                          parser.GetOptionValues(level, levels);
+                      }));
+    STF_ASSERT_EQ(std::size_t(2), levels.size());
+    STF_ASSERT_EQ(2, levels[1]);
+}
+
+// Parsing a range of arguments does not build an intermediate container
+STF_TEST(Allocations, ParseRangeSteadyState)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const std::vector<std::vector<std::string>> segments =
+    {
+        std::vector<std::string>(Test_Arguments, Test_Arguments + 8),
+        std::vector<std::string>(Test_Arguments + 8,
+                                 Test_Arguments + Test_Argument_Count)
+    };
+    const std::span<const char *> arguments(Test_Arguments,
+                                            Test_Argument_Count);
+
+    parser.ParseArguments(segments | std::views::join);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(segments | std::views::join);
+            parser.ClearOptions();
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("level"));
+}
+
+// Options that do not expect a value are counted without storing strings
+STF_TEST(Allocations, FlagsCountedWithoutAllocation)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    std::vector<std::string> arguments =
+    {
+        "program",
+        "-a" + std::string(10'000, 'v')
+    };
+    arguments.resize(1'002, "--verbose");
+
+    // Even the first parse does not allocate
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(11'000), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+}
+
+// Values of bound options are converted without storing strings
+STF_TEST(Allocations, BoundValuesWithoutAllocation)
+{
+    unsigned level = 0;
+    double ratio = 0.0;
+    int verbosity = 0;
+    const Terra::ProgramOptions::Options options =
+    {
+        {"level", "l", "level", true, true,
+         Terra::ProgramOptions::Bind(level, 0u, 9u)},
+        {"ratio", "r", "ratio", true, true,
+         Terra::ProgramOptions::Bind(ratio)},
+        {"verbose", "v", "verbose", true, false,
+         Terra::ProgramOptions::Bind(verbosity)}
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    std::vector<std::string> arguments = {"program"};
+
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("-vl");
+        arguments.emplace_back("7");
+        arguments.emplace_back("--ratio=0.123456789012345678");
+    }
+
+    // Even the first parse does not allocate
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(7u, level);
+    STF_ASSERT_EQ(0.123456789012345678, ratio);
+    STF_ASSERT_EQ(1'000, verbosity);
+}
+
+// Choices are matched without allocating once storage has grown
+STF_TEST(Allocations, ChoicesSteadyState)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        {"mode", "m", "mode", true, true, {},
+         Terra::ProgramOptions::ValueType::String, {},
+         {"read", "write", "append", "truncate"}}
+    };
+    Terra::ProgramOptions::Parser parser(options, {"-"}, {"--"}, "=", true);
+    std::vector<std::string> arguments = {"program"};
+
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("--mode=Append");
+        arguments.emplace_back("-m");
+        arguments.emplace_back("READ");
+    }
+
+    parser.ParseArguments(arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(2'000), parser.GetOptionChoices("mode").size());
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionChoice("mode"));
+}
+
+STF_TEST(Allocations, InternedValuesSteadyState)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        {"path", "p", "path", true, true}
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    auto table = std::make_shared<Terra::ProgramOptions::InternTable>();
+    std::vector<std::string> arguments = {"program"};
+
+    parser.SetInternTable(table);
+
+    // Values longer than the small string buffer would each be allocated
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("-p");
+        arguments.emplace_back("/var/spool/scheduler/queues/" +
+                               std::to_string(i % 10));
+    }
+
+    parser.ParseArguments(arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(1'000),
+                  parser.GetOptionInternedValues("path").size());
+    STF_ASSERT_EQ(std::size_t(10), table->Size());
+}
+
+STF_TEST(Allocations, ConstraintsCheckedWithoutAllocation)
+{
+    using Terra::ProgramOptions::ConstraintType;
+
+    Terra::ProgramOptions::Parser parser(Test_Options);
+
+    parser.SetConstraints({{ConstraintType::Required, {"pattern", "color"}},
+                           {ConstraintType::Requires, {"size", "all"}},
+                           {ConstraintType::Requires, {"level", "verbose"}}});
+    parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+}
+
+STF_TEST(Allocations, PresenceSnapshotWithoutAllocation)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const auto mask = parser.GetOptionMask({"all", "verbose"});
+
+    parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+    Terra::ProgramOptions::OptionPresence snapshot = parser.GetOptionPresence();
+
+    bool verbose = false;
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(Test_Argument_Count, Test_Arguments);
+            snapshot = parser.GetOptionPresence();
+            verbose = snapshot.All(mask) && (parser.GetOptionCounts()[1] > 3);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_TRUE(verbose);
+}
+
+STF_TEST(Allocations, RemainderNotCopied)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    std::vector<std::string> arguments = {"program", "-v", "--"};
+
+    parser.SetTerminators({"--"});
+
+    // The arguments following the terminator are passed to a child process
+    for (std::size_t i = 0; i < 10'000; i++)
+    {
+        arguments.emplace_back("--child-argument-that-is-not-stored");
+    }
+
+    std::span<const std::string> remainder;
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ParseArguments(arguments);
+            remainder = parser.GetRemainder(std::span(arguments));
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(10'000), remainder.size());
+    STF_ASSERT_EQ(std::size_t(0), parser.GetOptionCount(""));
+}
+
+STF_TEST(Allocations, UnknownOptionsNotCopied)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    std::vector<std::string> arguments = {"program", "-v"};
+
+    parser.SetUnknownOptions(
+        Terra::ProgramOptions::UnknownOptions::PassThroughWithValues);
+
+    // Unknown options and their values are forwarded to another program
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("--forwarded-option-that-is-not-stored");
+        arguments.emplace_back("value");
+    }
+
+    // Parsing once sizes the vector of positions
+    parser.ParseArguments(arguments);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(2'000), parser.GetUnknownPositions().size());
+    STF_ASSERT_EQ(std::size_t(0), parser.GetOptionCount(""));
+}
+
+STF_TEST(Allocations, ChildArgumentsReuseStorage)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    std::vector<std::string> arguments = {"program", "-v", "-p", "x"};
+    Terra::ProgramOptions::ArgumentVector child;
+
+    parser.ParseArguments(arguments);
+    const auto excluded = parser.GetOptionMask({"pattern"});
+
+    // Building the first command-line sizes the storage
+    child.Append("child");
+    parser.AppendOptions(child, excluded);
+    child.Append({"--pattern=", "y"});
+    child.Data();
+
+    // Building many similar command-lines reuses the storage
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 1'000; i++)
+            {
+                child.Clear();
+                child.Append("child");
+                parser.AppendOptions(child, excluded);
+                child.Append({"--pattern=", "y"});
+                child.Data();
+            }
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(3), child.Size());
+}
+
+STF_TEST(Allocations, TwoPassExactSizing)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    std::vector<std::string> arguments = {"program"};
+
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("-p");
+        arguments.emplace_back("x");
+        arguments.emplace_back("file");
+    }
+
+    parser.SetParseStrategy(Terra::ProgramOptions::ParseStrategy::TwoPass);
+
+    // Only one allocation is needed for each of the two vectors of values
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(2), allocations);
+    STF_ASSERT_EQ(std::size_t(1'000), parser.GetOptionCount("pattern"));
+    STF_ASSERT_EQ(std::size_t(1'000), parser.GetOptionCount(""));
+}
+
+// Reserved storage is retained across calls to ClearOptions()
+STF_TEST(Allocations, ReserveRetainedAcrossClear)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const std::string pattern = "pattern";
+    const std::string positional = "";
+    std::vector<std::string> arguments = {"program"};
+
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("--pattern=x");
+        arguments.emplace_back("file");
+    }
+
+    parser.Reserve(pattern, 1'000);
+    parser.Reserve(positional, 1'000);
+
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        std::size_t allocations = CountAllocations(
+            [&]()
+            {
+                parser.ClearOptions();
+                parser.ParseArguments(arguments);
+            });
+
+        STF_ASSERT_EQ(std::size_t(0), allocations);
+    }
+}
+
+// Reserved storage is retained when parse settings change
+STF_TEST(Allocations, ReserveRetainedAcrossSettings)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    std::vector<std::string> arguments = {"program"};
+
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.emplace_back("--pattern=x");
+        arguments.emplace_back("file");
+    }
+
+    parser.Reserve("pattern", 1'000);
+    parser.Reserve("", 1'000);
+
+    parser.SetConstraints({});
+    parser.SetTerminators({});
+    parser.SetOptionOrder(Terra::ProgramOptions::OptionOrder::Interleaved);
+    parser.SetUnknownOptions(Terra::ProgramOptions::UnknownOptions::Reject);
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_EQ(std::size_t(1'000), parser.GetOptionCount("pattern"));
+}
+
+// Parsers acquired from a warm pool parse without allocating
+STF_TEST(Allocations, ParserPoolSteadyState)
+{
+    Terra::ProgramOptions::ParserPool<> pool{
+                                Terra::ProgramOptions::Parser(Test_Options)};
+
+    {
+        auto handle = pool.Acquire();
+        handle->ParseArguments(Test_Argument_Count, Test_Arguments);
+    }
+
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 3; i++)
+            {
+                auto handle = pool.Acquire();
+                handle->ParseArguments(Test_Argument_Count, Test_Arguments);
+            }
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+}
+
+// Keys of map options are found without allocating
+STF_TEST(Allocations, MapLookupWithoutAllocation)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        {"define", "D", "define", true, true, {},
+         Terra::ProgramOptions::ValueType::Map}
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    std::vector<std::string> arguments = {"program"};
+
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        arguments.emplace_back("--define=a_long_key_name_" +
+                               std::to_string(i) + "=value");
+    }
+
+    parser.ParseArguments(arguments);
+
+    const std::string_view key = "a_long_key_name_42";
+    bool found = false;
+    std::size_t allocations = CountAllocations(
+        [&]()
+        {
+            const auto &map = parser.GetOptionMap("define");
+            found = (map.Find(key) == std::string_view("value")) &&
+                    !map.Contains("missing");
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+    STF_ASSERT_TRUE(found);
+
+    // Parsing the same arguments again does not allocate
+    allocations = CountAllocations(
+        [&]()
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(arguments);
+        });
+
+    STF_ASSERT_EQ(std::size_t(0), allocations);
+}
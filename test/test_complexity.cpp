@@ -0,0 +1,732 @@
+/*
+ *  test_complexity.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file will test that the time required to parse arguments grows
+ *      linearly with the size of the input and is independent of the number
+ *      of program options, even for adversarial inputs crafted to defeat
+ *      the matching logic (e.g., long arguments sharing long prefixes with
+ *      many option names, or strings crafted to collide in hash tables).
+ *      It will also test that the size of exception messages does not
+ *      depend on the size of the offending input.
+ *
+ *      Timing is measured as the minimum of several runs and the budgets
+ *      allow a generous constant factor, so these tests detect super-linear
+ *      behavior without being sensitive to noise on a loaded machine.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <terra/program_options/program_options.h>
+#include <terra/program_options/fingerprint.h>
+#include <terra/program_options/intern_table.h>
+#include <terra/stf/stf.h>
+
+namespace
+{
+
+// Number of times each measurement is repeated (the minimum is used)
+constexpr std::size_t Measurement_Runs = 7;
+
+// Define a set of arguments along with an argv-style array referring to them
+struct Arguments
+{
+    Arguments() : strings{"program"}
+    {
+    }
+
+    void Add(std::string argument)
+    {
+        strings.emplace_back(std::move(argument));
+    }
+
+    std::vector<std::string> strings;
+};
+
+// Return the minimum time in seconds required to call the function
+template<typename Function>
+double MeasureTime(const Function &function)
+{
+    double minimum = 0.0;
+
+    for (std::size_t i = 0; i < Measurement_Runs; i++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double> elapsed =
+                                    std::chrono::steady_clock::now() - start;
+        minimum = (i == 0) ? elapsed.count() : std::min(minimum,
+                                                        elapsed.count());
+    }
+
+    return minimum;
+}
+
+// Produce options whose long names share a long common prefix
+Terra::ProgramOptions::Options MakePrefixOptions(std::size_t count,
+                                                 const std::string &prefix)
+{
+    Terra::ProgramOptions::Options options;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        options.push_back({"opt" + std::to_string(i),
+                           "",
+                           prefix + std::to_string(i),
+                           true,
+                           true});
+    }
+
+    return options;
+}
+
+// Constants of the Fingerprint mixing function, which is also that of
+// MurmurHash64A
+constexpr std::uint64_t Fingerprint_Multiplier = 0xc6a4a7935bd1e995ULL;
+constexpr unsigned Fingerprint_Shift = 47;
+constexpr std::uint64_t Fingerprint_Initial_State = 0x9e3779b97f4a7c15ULL;
+
+// Mix a block of eight octets as the Fingerprint does, without the state
+constexpr std::uint64_t MixBlock(std::uint64_t block)
+{
+    block *= Fingerprint_Multiplier;
+    block ^= block >> Fingerprint_Shift;
+    return block * Fingerprint_Multiplier;
+}
+
+// State of the (unseeded) Fingerprint once the length of a string of
+// sixteen octets is mixed
+constexpr std::uint64_t Fingerprint_String_State =
+    (Fingerprint_Initial_State ^ MixBlock(16)) * Fingerprint_Multiplier;
+
+// State of MurmurHash64A, which libstdc++ uses for std::hash of strings,
+// once seeded for a string of sixteen octets (with other libraries, strings
+// crafted against this state are merely distinct)
+constexpr std::uint64_t Murmur_String_State =
+    0xc70f6907ULL ^ (16 * Fingerprint_Multiplier);
+
+// Produce distinct strings of sixteen octets that collide in a hash mixing
+// eight octets at a time from the given state (e.g., having the same
+// Fingerprint), as an adversary might to make every string select the same
+// entry of a hash table.  The first eight octets are digits and the last
+// eight are found by inverting the mixing function, skipping strings
+// containing a null or excluded character.
+std::vector<std::string> MakeCollidingStrings(
+                            std::size_t count,
+                            std::uint64_t state = Fingerprint_String_State,
+                            char excluded = '=')
+{
+    // Find the multiplicative inverse of the multiplier (mod 2^64)
+    std::uint64_t inverse = Fingerprint_Multiplier;
+    for (std::size_t i = 0; i < 5; i++)
+    {
+        inverse *= 2 - Fingerprint_Multiplier * inverse;
+    }
+
+    std::vector<std::string> strings;
+
+    for (std::uint64_t i = 0; strings.size() < count; i++)
+    {
+        std::string digits = std::to_string(i);
+        std::string string(8 - digits.size(), '0');
+        string += digits;
+
+        std::uint64_t first = 0;
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            first |= std::uint64_t(static_cast<unsigned char>(string[j]))
+                     << (j * 8);
+        }
+
+        // Choose the second block so that mixing it clears the state
+        std::uint64_t second = ((state ^ MixBlock(first)) *
+                                Fingerprint_Multiplier) * inverse;
+        second ^= second >> Fingerprint_Shift;
+        second *= inverse;
+
+        bool usable = true;
+        for (std::size_t j = 0; j < 8; j++)
+        {
+            const char c = static_cast<char>((second >> (j * 8)) & 0xff);
+            if ((c == '\0') || (c == excluded)) usable = false;
+            string += c;
+        }
+
+        if (usable) strings.push_back(std::move(string));
+    }
+
+    return strings;
+}
+
+// Parse the arguments, returning true if an exception was thrown
+bool ParseFails(Terra::ProgramOptions::Parser &parser,
+                const std::vector<std::string> &arguments)
+{
+    try
+    {
+        parser.ClearOptions();
+        parser.ParseArguments(arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &)
+    {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+// Parse time does not depend on the number of options sharing a prefix
+STF_TEST(Complexity, OptionCountIndependent)
+{
+    const std::string prefix(1'000, 'x');
+    const auto small_options = MakePrefixOptions(64, prefix);
+    const auto large_options = MakePrefixOptions(4'096, prefix);
+    Terra::ProgramOptions::Parser small_parser(small_options);
+    Terra::ProgramOptions::Parser large_parser(large_options);
+    Arguments arguments;
+
+    // Each argument matches an option only after the shared prefix
+    for (std::size_t i = 0; i < 200; i++)
+    {
+        arguments.Add("--" + prefix + std::to_string(i % 64) + "=value");
+    }
+
+    const double small_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(small_parser, arguments.strings));
+        });
+    const double large_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(large_parser, arguments.strings));
+        });
+
+    STF_ASSERT_EQ(std::size_t(4), large_parser.GetOptionCount("opt0"));
+    STF_ASSERT_LT(large_time, small_time * 4.0);
+}
+
+// Rejecting an argument that nearly matches many options is also fast
+STF_TEST(Complexity, RejectedOptionCountIndependent)
+{
+    const std::string prefix(1'000, 'x');
+    const auto small_options = MakePrefixOptions(64, prefix);
+    const auto large_options = MakePrefixOptions(4'096, prefix);
+    Terra::ProgramOptions::Parser small_parser(small_options);
+    Terra::ProgramOptions::Parser large_parser(large_options);
+    Arguments arguments;
+
+    // The argument shares the prefix, but matches no option
+    arguments.Add("--" + prefix + "z");
+
+    const double small_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 200; i++)
+            {
+                STF_ASSERT_TRUE(ParseFails(small_parser, arguments.strings));
+            }
+        });
+    const double large_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 200; i++)
+            {
+                STF_ASSERT_TRUE(ParseFails(large_parser, arguments.strings));
+            }
+        });
+
+    STF_ASSERT_LT(large_time, small_time * 4.0);
+}
+
+// Parse time grows linearly with the length of a long option argument
+STF_TEST(Complexity, LongArgumentLengthLinear)
+{
+    Terra::ProgramOptions::Options options;
+
+    // Option names are nested prefixes of one another (a, aa, aaa, ...)
+    for (std::size_t i = 1; i <= 256; i++)
+    {
+        options.push_back({"opt" + std::to_string(i),
+                           "",
+                           std::string(i, 'a'),
+                           true,
+                           true});
+    }
+
+    Terra::ProgramOptions::Parser parser(options, {"-"}, {"--"}, "=", true);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    // The arguments match every option name as a prefix, but match no option
+    short_arguments.Add("--" + std::string(4'096, 'A') + "=v");
+    long_arguments.Add("--" + std::string(32'768, 'A') + "=v");
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 50; i++)
+            {
+                STF_ASSERT_TRUE(ParseFails(parser, short_arguments.strings));
+            }
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 50; i++)
+            {
+                STF_ASSERT_TRUE(ParseFails(parser, long_arguments.strings));
+            }
+        });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Parse time grows linearly with the length of a single argument
+STF_TEST(Complexity, SingleArgumentLengthLinear)
+{
+    const auto options = MakePrefixOptions(256, std::string(64, 'y'));
+    Terra::ProgramOptions::Parser parser(options);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    short_arguments.Add("--" + std::string(64, 'y') + "1=" +
+                        std::string(8'192, 'v'));
+    long_arguments.Add("--" + std::string(64, 'y') + "1=" +
+                       std::string(65'536, 'v'));
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 100; i++)
+            {
+                STF_ASSERT_FALSE(ParseFails(parser, short_arguments.strings));
+            }
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 100; i++)
+            {
+                STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+            }
+        });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Parse time grows linearly with the length of a short option bundle
+STF_TEST(Complexity, ShortBundleLinear)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        { "verbose", "v", "verbose", true, false }
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    short_arguments.Add("-" + std::string(4'096, 'v'));
+    long_arguments.Add("-" + std::string(32'768, 'v'));
+
+    // Parse once so that storage is allocated before timing
+    STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 20; i++)
+            {
+                STF_ASSERT_FALSE(ParseFails(parser, short_arguments.strings));
+            }
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 20; i++)
+            {
+                STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+            }
+        });
+
+    STF_ASSERT_EQ(std::size_t(32'768), parser.GetOptionCount("verbose"));
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Parse time grows linearly with the number of arguments
+STF_TEST(Complexity, ArgumentCountLinear)
+{
+    const auto options = MakePrefixOptions(1'000, "option-");
+    Terra::ProgramOptions::Parser parser(options);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        short_arguments.Add("--option-" + std::to_string(i) + "=value");
+    }
+    for (std::size_t i = 0; i < 8'000; i++)
+    {
+        long_arguments.Add("--option-" + std::to_string(i % 1'000) + "=value");
+    }
+
+    // Parse once so that storage is allocated before timing
+    STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, short_arguments.strings));
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+        });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Parse time grows (nearly) linearly with the length of an interval list,
+// even when the intervals are given in descending order
+STF_TEST(Complexity, IntervalListLinear)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        { "cpus", "c", "cpus", false, true, {},
+          Terra::ProgramOptions::ValueType::IntervalSet }
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    // Disjoint intervals given in descending order
+    const auto make_list = [](std::size_t count)
+    {
+        std::string list = "--cpus=";
+        for (std::size_t i = count; i > 0; i--)
+        {
+            list += std::to_string(i * 2);
+            if (i > 1) list += ',';
+        }
+        return list;
+    };
+    short_arguments.Add(make_list(8'192));
+    long_arguments.Add(make_list(65'536));
+
+    // Parse once so that storage is allocated before timing
+    STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+    STF_ASSERT_EQ(std::size_t(65'536),
+                  parser.GetOptionIntervals("cpus").Size());
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, short_arguments.strings));
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+        });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Time to compile choices grows (nearly) linearly with the number of choices
+STF_TEST(Complexity, ChoiceCountLinear)
+{
+    const auto make_options = [](std::size_t count)
+    {
+        Terra::ProgramOptions::Options options =
+        {
+            { "mode", "m", "mode", false, true }
+        };
+        for (std::size_t i = 0; i < count; i++)
+        {
+            options[0].choices.push_back("choice-" + std::to_string(i));
+        }
+        return options;
+    };
+    const auto small_options = make_options(2'048);
+    const auto large_options = make_options(16'384);
+    Arguments arguments;
+
+    arguments.Add("--mode=choice-16383");
+
+    const double small_time = MeasureTime(
+        [&]()
+        {
+            Terra::ProgramOptions::Parser parser(small_options);
+            STF_ASSERT_TRUE(ParseFails(parser, arguments.strings));
+        });
+    const double large_time = MeasureTime(
+        [&]()
+        {
+            Terra::ProgramOptions::Parser parser(large_options);
+            STF_ASSERT_FALSE(ParseFails(parser, arguments.strings));
+            STF_ASSERT_EQ(std::uint32_t(16'383),
+                          parser.GetOptionChoice("mode"));
+        });
+
+    STF_ASSERT_LT(large_time, small_time * 24.0);
+}
+
+// Parse time grows linearly with the number of map keys, even if the keys
+// are crafted to collide
+STF_TEST(Complexity, MapKeysAdversarial)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        { "define", "D", "define", true, true, {},
+          Terra::ProgramOptions::ValueType::Map }
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    const auto keys = MakeCollidingStrings(8'000);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    // The keys would all select the same entry if indexed by a fingerprint
+    Terra::ProgramOptions::Fingerprint first;
+    Terra::ProgramOptions::Fingerprint last;
+    first.Update(keys.front());
+    last.Update(keys.back());
+    STF_ASSERT_NE(keys.front(), keys.back());
+    STF_ASSERT_EQ(first.Value(), last.Value());
+
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        if (i < 1'000) short_arguments.Add("--define=" + keys[i] + "=1");
+        long_arguments.Add("--define=" + keys[i] + "=1");
+    }
+
+    // Parse once so that storage is allocated before timing
+    STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+    STF_ASSERT_EQ(std::size_t(8'000), parser.GetOptionMap("define").Size());
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, short_arguments.strings));
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+        });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Parse time grows linearly with the number of deduplicated values, even if
+// the values are crafted to collide
+STF_TEST(Complexity, DeduplicatedValuesAdversarial)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        { "exclude", "x", "exclude", true, true, {},
+          Terra::ProgramOptions::ValueType::String, {}, {}, '\0', '=',
+          Terra::ProgramOptions::DuplicateKeys::LastWins,
+          Terra::ProgramOptions::Deduplicate::Exact }
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    const auto values = MakeCollidingStrings(8'000);
+    Arguments short_arguments;
+    Arguments long_arguments;
+
+    for (std::size_t i = 0; i < values.size(); i++)
+    {
+        if (i < 1'000) short_arguments.Add("--exclude=" + values[i]);
+        long_arguments.Add("--exclude=" + values[i]);
+    }
+
+    // Parse once so that storage is allocated before timing
+    STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+    STF_ASSERT_EQ(std::size_t(8'000),
+                  parser.GetOptionStrings("exclude").size());
+
+    const double short_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, short_arguments.strings));
+        });
+    const double long_time = MeasureTime(
+        [&]()
+        {
+            STF_ASSERT_FALSE(ParseFails(parser, long_arguments.strings));
+        });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Interning strings takes time linear in their number, even if the strings
+// are crafted to collide
+STF_TEST(Complexity, InternedStringsAdversarial)
+{
+    const auto strings = MakeCollidingStrings(8'000, Murmur_String_State);
+
+    const auto intern = [&](std::size_t count)
+    {
+        Terra::ProgramOptions::InternTable table;
+
+        for (std::size_t i = 0; i < count; i++) table.Intern(strings[i]);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            STF_ASSERT_TRUE(table.Find(strings[i]).has_value());
+        }
+        STF_ASSERT_EQ(count, table.Size());
+    };
+
+    const double short_time = MeasureTime([&]() { intern(1'000); });
+    const double long_time = MeasureTime([&]() { intern(8'000); });
+
+    STF_ASSERT_LT(long_time, short_time * 24.0);
+}
+
+// Time to compile choices grows (nearly) linearly with the number of
+// choices, even if the choices are crafted to collide
+STF_TEST(Complexity, ChoicesAdversarial)
+{
+    const auto choices = MakeCollidingStrings(8'000);
+    const auto make_options = [&](std::size_t count)
+    {
+        Terra::ProgramOptions::Options options =
+        {
+            { "mode", "m", "mode", false, true }
+        };
+        options[0].choices.assign(choices.begin(), choices.begin() + count);
+        return options;
+    };
+    const auto small_options = make_options(1'000);
+    const auto large_options = make_options(8'000);
+    Arguments arguments;
+
+    arguments.Add("--mode=" + choices.back());
+
+    const double small_time = MeasureTime(
+        [&]()
+        {
+            Terra::ProgramOptions::Parser parser(small_options);
+            STF_ASSERT_TRUE(ParseFails(parser, arguments.strings));
+        });
+    const double large_time = MeasureTime(
+        [&]()
+        {
+            Terra::ProgramOptions::Parser parser(large_options);
+            STF_ASSERT_FALSE(ParseFails(parser, arguments.strings));
+            STF_ASSERT_EQ(std::uint32_t(7'999),
+                          parser.GetOptionChoice("mode"));
+        });
+
+    STF_ASSERT_LT(large_time, small_time * 24.0);
+}
+
+// Exception messages do not grow with the size of the offending input
+STF_TEST(Complexity, ErrorMessageBounded)
+{
+    const Terra::ProgramOptions::Options options =
+    {
+        { "all",   "a", "all",   false, false },
+        { "level", "l", "level", false, true  }
+    };
+    Terra::ProgramOptions::Parser parser(options);
+    const std::string huge(1'000'000, 'z');
+    const std::vector<std::vector<std::string>> inputs =
+    {
+        {"program", "--" + huge},
+        {"program", "-" + huge},
+        {"program", "--all=" + huge},
+        {"program", "--level=", huge}
+    };
+
+    for (const auto &input : inputs)
+    {
+        try
+        {
+            parser.ClearOptions();
+            parser.ParseArguments(input);
+            STF_ASSERT_TRUE(input.size() == 3);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_LT(std::string(e.what()).length(), std::size_t(512));
+        }
+    }
+
+    // Conversion errors quote the value given
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{"program",
+                                                   "--level=" + huge});
+    try
+    {
+        int level{};
+        parser.GetOptionValue("level", level);
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_LT(std::string(e.what()).length(), std::size_t(512));
+    }
+
+    // Truncation does not split a UTF-8 character (the odd-length prefix
+    // places a continuation octet at the truncation point)
+    const std::string greek = "\xCE\xB1";
+    std::string argument = "--x";
+    while (argument.length() < 1'000) argument += greek;
+    try
+    {
+        parser.ClearOptions();
+        parser.ParseArguments(std::vector<std::string>{"program", argument});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        const std::string message = e.what();
+        STF_ASSERT_TRUE(message.ends_with(greek + "..."));
+    }
+}
+
+// Clearing options does not depend on the number of options
+STF_TEST(Complexity, ClearOptionsConstantTime)
+{
+    const auto small_options = MakePrefixOptions(64, "option-");
+    const auto large_options = MakePrefixOptions(16'384, "option-");
+    Terra::ProgramOptions::Parser small_parser(small_options);
+    Terra::ProgramOptions::Parser large_parser(large_options);
+    Arguments arguments;
+
+    arguments.Add("--option-1=value");
+
+    const double small_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 10'000; i++)
+            {
+                STF_ASSERT_FALSE(ParseFails(small_parser, arguments.strings));
+            }
+        });
+    const double large_time = MeasureTime(
+        [&]()
+        {
+            for (std::size_t i = 0; i < 10'000; i++)
+            {
+                STF_ASSERT_FALSE(ParseFails(large_parser, arguments.strings));
+            }
+        });
+
+    STF_ASSERT_LT(large_time, small_time * 4.0);
+}
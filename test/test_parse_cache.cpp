@@ -0,0 +1,268 @@
+/*
+ *  test_parse_cache.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file will test the ParseCache and Fingerprint objects.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <terra/program_options/program_options.h>
+#include <terra/program_options/basic_parser.h>
+#include <terra/program_options/fingerprint.h>
+#include <terra/program_options/parse_cache.h>
+#include <terra/stf/stf.h>
+
+namespace
+{
+
+// clang-format off
+const Terra::ProgramOptions::Options Test_Options =
+{
+//    Name       Short    Long        Multi  Argument
+    { "all",       "a",   "all",      false, false },
+    { "pattern",   "p",   "pattern",  true,  true  },
+    { "color",     "c",   "color",    false, true  },
+    { "verbose",   "v",   "verbose",  true,  false }
+};
+// clang-format on
+
+} // namespace
+
+// Fingerprints do not change across platforms or releases
+STF_TEST(Fingerprint, StableValues)
+{
+    Terra::ProgramOptions::Fingerprint empty;
+    STF_ASSERT_EQ(std::uint64_t(0x84d69dcef1e6733a), empty.Value());
+
+    Terra::ProgramOptions::Fingerprint fingerprint;
+    fingerprint.Update("program");
+    fingerprint.Update("--pattern=fingerprint");
+    fingerprint.Update(std::uint64_t(42));
+    STF_ASSERT_EQ(std::uint64_t(0x3ed9a0296f7e8bef), fingerprint.Value());
+}
+
+// Strings are delimited, so differently split strings differ
+STF_TEST(Fingerprint, StringsDelimited)
+{
+    Terra::ProgramOptions::Fingerprint first;
+    first.Update("ab");
+    first.Update("c");
+
+    Terra::ProgramOptions::Fingerprint second;
+    second.Update("a");
+    second.Update("bc");
+
+    Terra::ProgramOptions::Fingerprint seeded(1);
+    seeded.Update("ab");
+    seeded.Update("c");
+
+    STF_ASSERT_NE(first.Value(), second.Value());
+    STF_ASSERT_NE(first.Value(), seeded.Value());
+}
+
+// Identically configured parsers have the same specification fingerprint
+STF_TEST(Fingerprint, SpecFingerprint)
+{
+    Terra::ProgramOptions::Parser parser1(Test_Options);
+    Terra::ProgramOptions::Parser parser2(Test_Options);
+    Terra::ProgramOptions::Parser parser3(Test_Options, {"/"}, {"/"}, ":");
+    Terra::ProgramOptions::Parser parser4(Test_Options,
+                                          {"-"},
+                                          {"--"},
+                                          "=",
+                                          true);
+    Terra::ProgramOptions::Options options = Test_Options;
+    options[1].multiple_allowed = false;
+    Terra::ProgramOptions::Parser parser5(options);
+
+    STF_ASSERT_EQ(parser1.GetSpecFingerprint(), parser2.GetSpecFingerprint());
+    STF_ASSERT_NE(parser1.GetSpecFingerprint(), parser3.GetSpecFingerprint());
+    STF_ASSERT_NE(parser1.GetSpecFingerprint(), parser4.GetSpecFingerprint());
+    STF_ASSERT_NE(parser1.GetSpecFingerprint(), parser5.GetSpecFingerprint());
+
+    // Setting the options recomputes the fingerprint
+    parser5.SetOptions(Test_Options);
+    STF_ASSERT_EQ(parser1.GetSpecFingerprint(), parser5.GetSpecFingerprint());
+}
+
+// The fingerprint of parsed results reflects the values given
+STF_TEST(Fingerprint, ResultFingerprint)
+{
+    Terra::ProgramOptions::Parser parser(Test_Options);
+    const std::uint64_t nothing_parsed = parser.GetFingerprint();
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-a", "-p", "x", "--color=red", "-p", "y", "file"});
+    const std::uint64_t result = parser.GetFingerprint();
+    STF_ASSERT_NE(nothing_parsed, result);
+
+    // The order of different options does not matter
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-p", "x", "-c", "red", "-p", "y", "-a", "file"});
+    STF_ASSERT_EQ(result, parser.GetFingerprint());
+
+    // The order of values for the same option does
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-a", "-p", "y", "--color=red", "-p", "x", "file"});
+    STF_ASSERT_NE(result, parser.GetFingerprint());
+
+    // Counts of options without values are included
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{"program", "-v"});
+    const std::uint64_t verbose = parser.GetFingerprint();
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{"program", "-vv"});
+    STF_ASSERT_NE(verbose, parser.GetFingerprint());
+
+    // Cleared results have the same fingerprint as nothing parsed
+    parser.ClearOptions();
+    STF_ASSERT_EQ(nothing_parsed, parser.GetFingerprint());
+}
+
+// Parsing the same arguments returns the same shared result
+STF_TEST(ParseCache, HitReturnsSharedResult)
+{
+    Terra::ProgramOptions::ParseCache<> cache{
+                                Terra::ProgramOptions::Parser(Test_Options)};
+    const std::vector<std::string> arguments =
+    {
+        "program", "-a", "-p", "x", "file"
+    };
+
+    auto first = cache.ParseArguments(arguments);
+    STF_ASSERT_TRUE(first->OptionGiven("all"));
+    STF_ASSERT_EQ(std::string_view("x"), first->GetOptionStringView("pattern"));
+    STF_ASSERT_EQ(std::size_t(1), cache.Size());
+
+    // Different forms of the same arguments share the entry
+    const std::vector<std::string_view> views(arguments.begin(),
+                                              arguments.end());
+    const char *argv[] = {"program", "-a", "-p", "x", "file"};
+
+    STF_ASSERT_EQ(first.get(), cache.ParseArguments(arguments).get());
+    STF_ASSERT_EQ(first.get(), cache.ParseArguments(views).get());
+    STF_ASSERT_EQ(first.get(), cache.ParseArguments(5, argv).get());
+    STF_ASSERT_EQ(std::size_t(1), cache.Size());
+
+    // Different arguments produce a different result
+    auto second = cache.ParseArguments(
+                    std::vector<std::string>{"program", "-ap", "x", "file"});
+    STF_ASSERT_NE(first.get(), second.get());
+    STF_ASSERT_EQ(first->GetFingerprint(), second->GetFingerprint());
+    STF_ASSERT_EQ(std::size_t(2), cache.Size());
+
+    // Results remain valid after the cache is cleared
+    cache.Clear();
+    STF_ASSERT_EQ(std::size_t(0), cache.Size());
+    STF_ASSERT_EQ(std::string("file"), first->GetOptionString(""));
+}
+
+// The least recently used entry is discarded when the cache is full
+STF_TEST(ParseCache, LeastRecentlyUsedDiscarded)
+{
+    Terra::ProgramOptions::ParseCache<> cache{
+                            Terra::ProgramOptions::Parser(Test_Options), 2};
+    const std::vector<std::string> a = {"program", "a"};
+    const std::vector<std::string> b = {"program", "b"};
+    const std::vector<std::string> c = {"program", "c"};
+
+    auto result_a = cache.ParseArguments(a);
+    auto result_b = cache.ParseArguments(b);
+
+    // Using a makes b the least recently used
+    STF_ASSERT_EQ(result_a.get(), cache.ParseArguments(a).get());
+    auto result_c = cache.ParseArguments(c);
+    STF_ASSERT_EQ(std::size_t(2), cache.Size());
+
+    STF_ASSERT_EQ(result_a.get(), cache.ParseArguments(a).get());
+    STF_ASSERT_EQ(result_c.get(), cache.ParseArguments(c).get());
+    STF_ASSERT_NE(result_b.get(), cache.ParseArguments(b).get());
+}
+
+// Arguments that fail to parse are not cached
+STF_TEST(ParseCache, ErrorsNotCached)
+{
+    Terra::ProgramOptions::ParseCache<> cache{
+                                Terra::ProgramOptions::Parser(Test_Options)};
+    const std::vector<std::string> arguments = {"program", "-a", "-a"};
+
+    for (int i = 0; i < 2; i++)
+    {
+        try
+        {
+            cache.ParseArguments(arguments);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::MultipleInstances,
+                          e.options_error);
+        }
+    }
+
+    STF_ASSERT_EQ(std::size_t(0), cache.Size());
+}
+
+// A cache of BasicParser objects may be used
+STF_TEST(ParseCache, BasicParserCache)
+{
+    Terra::ProgramOptions::ParseCache<Terra::ProgramOptions::BasicParser<>>
+        cache{Terra::ProgramOptions::BasicParser<>(Test_Options)};
+
+    auto result = cache.ParseArguments(
+                    std::vector<std::string>{"program", "--pattern=foo"});
+    STF_ASSERT_EQ(std::string("foo"), result->GetOptionString("pattern"));
+}
+
+// Multiple threads may use the cache and share results concurrently
+STF_TEST(ParseCache, ConcurrentUse)
+{
+    Terra::ProgramOptions::ParseCache<> cache{
+                            Terra::ProgramOptions::Parser(Test_Options), 4};
+    std::vector<std::thread> threads;
+    std::array<bool, 4> success{};
+
+    for (std::size_t t = 0; t < success.size(); t++)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                bool passed = true;
+
+                for (std::size_t i = 0; i < 1'000; i++)
+                {
+                    const std::string value = std::to_string(i % 6);
+                    auto result = cache.ParseArguments(
+                        std::vector<std::string>{"program", "-vp", value});
+
+                    passed = passed &&
+                             (result->GetOptionString("pattern") == value) &&
+                             (result->GetOptionCount("verbose") == 1);
+                }
+
+                success[t] = passed;
+            });
+    }
+
+    for (auto &thread : threads) thread.join();
+
+    for (const auto passed : success) STF_ASSERT_TRUE(passed);
+    STF_ASSERT_EQ(std::size_t(4), cache.Size());
+}
@@ -0,0 +1,178 @@
+/*
+ *  test_parser_pool.cpp
+ *
+ *  Copyright (C) 2024
+ *  Terrapane Corporation
+ *  All Rights Reserved
+ *
+ *  Author:
+ *      Paul E. Jones <paulej@packetizer.com>
+ *
+ *  Description:
+ *      This file will test the ParserPool object.
+ *
+ *  Portability Issues:
+ *      None.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <terra/program_options/program_options.h>
+#include <terra/program_options/basic_parser.h>
+#include <terra/program_options/parser_pool.h>
+#include <terra/stf/stf.h>
+
+namespace
+{
+
+// clang-format off
+const Terra::ProgramOptions::Options Test_Options =
+{
+//    Name       Short    Long        Multi  Argument
+    { "all",       "a",   "all",      false, false },
+    { "pattern",   "p",   "pattern",  true,  true  },
+    { "color",     "c",   "color",    false, true  }
+};
+// clang-format on
+
+} // namespace
+
+// Parsers acquired from the pool are configured like the prototype
+STF_TEST(ParserPool, AcquireConfiguredParser)
+{
+    Terra::ProgramOptions::Parser prototype(Test_Options,
+                                            {"-"},
+                                            {"--"},
+                                            "=",
+                                            true);
+
+    // Options parsed by the prototype are not seen by pooled parsers
+    prototype.ParseArguments(std::vector<std::string>{"program", "-a"});
+
+    Terra::ProgramOptions::ParserPool<> pool(prototype);
+    auto handle = pool.Acquire();
+
+    STF_ASSERT_FALSE(handle->OptionGiven("all"));
+
+    handle->ParseArguments(
+        std::vector<std::string>{"program", "--PATTERN=foo", "file"});
+    STF_ASSERT_EQ(std::string("foo"), (*handle).GetOptionString("pattern"));
+    STF_ASSERT_EQ(std::string("file"), handle.get()->GetOptionString(""));
+}
+
+// Returned parsers are cleared and reused
+STF_TEST(ParserPool, ParserReused)
+{
+    Terra::ProgramOptions::ParserPool<> pool{
+                                Terra::ProgramOptions::Parser(Test_Options)};
+    Terra::ProgramOptions::Parser *first = nullptr;
+
+    {
+        auto handle = pool.Acquire();
+        first = handle.get();
+        handle->ParseArguments(std::vector<std::string>{"program", "-a"});
+    }
+
+    auto handle = pool.Acquire();
+    STF_ASSERT_EQ(first, handle.get());
+    STF_ASSERT_FALSE(handle->OptionGiven("all"));
+
+    // A second concurrently held handle refers to a different parser
+    auto other = pool.Acquire();
+    STF_ASSERT_NE(handle.get(), other.get());
+
+    // Handles may be moved and released explicitly
+    auto moved = std::move(other);
+    STF_ASSERT_TRUE(other.get() == nullptr);
+    moved.Release();
+    STF_ASSERT_TRUE(moved.get() == nullptr);
+}
+
+// Pools do not share parsers
+STF_TEST(ParserPool, PoolsIsolated)
+{
+    const Terra::ProgramOptions::Options other_options =
+    {
+        { "verbose", "v", "verbose", true, false }
+    };
+    Terra::ProgramOptions::ParserPool<> pool1{
+                                Terra::ProgramOptions::Parser(Test_Options)};
+    Terra::ProgramOptions::ParserPool<> pool2{
+                                Terra::ProgramOptions::Parser(other_options)};
+
+    // Return a parser to each pool so both are in this thread's cache
+    pool1.Acquire();
+    pool2.Acquire();
+
+    auto handle1 = pool1.Acquire();
+    auto handle2 = pool2.Acquire();
+
+    handle1->ParseArguments(std::vector<std::string>{"program", "-a"});
+    handle2->ParseArguments(std::vector<std::string>{"program", "-vv"});
+
+    STF_ASSERT_TRUE(handle1->OptionGiven("all"));
+    STF_ASSERT_EQ(std::size_t(2), handle2->GetOptionCount("verbose"));
+}
+
+// A pool of BasicParser objects may be used
+STF_TEST(ParserPool, BasicParserPool)
+{
+    Terra::ProgramOptions::ParserPool<Terra::ProgramOptions::BasicParser<>>
+        pool{Terra::ProgramOptions::BasicParser<>(Test_Options)};
+
+    auto handle = pool.Acquire();
+    handle->ParseArguments(std::vector<std::string>{"program", "-p", "x"});
+    STF_ASSERT_EQ(std::string("x"), handle->GetOptionString("pattern"));
+}
+
+// The pool may be used from many threads concurrently
+STF_TEST(ParserPool, ConcurrentUse)
+{
+    Terra::ProgramOptions::ParserPool<> pool(
+                                Terra::ProgramOptions::Parser(Test_Options),
+                                2);
+    std::atomic<std::size_t> failures{0};
+    std::vector<std::thread> threads;
+
+    for (std::size_t t = 0; t < 8; t++)
+    {
+        threads.emplace_back(
+            [&pool, &failures, t]()
+            {
+                const std::string value = "value" + std::to_string(t);
+                const std::vector<std::string> arguments =
+                {
+                    "program", "-a", "--pattern", value, "-p", value
+                };
+
+                for (std::size_t i = 0; i < 1'000; i++)
+                {
+                    // Hold several parsers so the shared list is exercised
+                    auto handle = pool.Acquire();
+                    auto extra1 = pool.Acquire();
+                    auto extra2 = pool.Acquire();
+                    auto extra3 = pool.Acquire();
+                    auto extra4 = pool.Acquire();
+
+                    handle->ParseArguments(arguments);
+                    if ((handle->GetOptionCount("pattern") != 2) ||
+                        (handle->GetOptionString("pattern") != value) ||
+                        extra4->OptionGiven("all"))
+                    {
+                        failures++;
+                    }
+
+                    // Return a parser on a different thread at times
+                    if ((i % 100) == 0)
+                    {
+                        std::thread([h = std::move(extra1)]() {}).join();
+                    }
+                }
+            });
+    }
+
+    for (auto &thread : threads) thread.join();
+
+    STF_ASSERT_EQ(std::size_t(0), failures.load());
+}
@@ -15,7 +15,17 @@
  *      None.
  */
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <list>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <tuple>
 #include <terra/program_options/program_options.h>
+#include <terra/program_options/basic_parser.h>
+#include <terra/program_options/option_binding.h>
 #include <terra/stf/stf.h>
 
 // The following is used to test the move constructor
@@ -1183,3 +1193,2194 @@ STF_TEST(ProgramOptions, TestZeroLengthArgument)
     STF_ASSERT_EQ(std::string(""), filenames[2]);
     STF_ASSERT_EQ(std::string("file3"), filenames[3]);
 }
+
+// Test case insensitive matching of long and short options
+STF_TEST(ProgramOptions, TestCaseInsensitive)
+{
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "all",       "a",   "all",      false, false },
+        { "pattern",   "p",   "pattern",  true,  true  },
+        { "color",     "c",   "Color",    false, true  },
+        { "size",      "S",   "min-size", false, true  }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options, {"-"}, {"--"}, "=", true);
+
+    // Simulate command-line arguments
+    const std::vector<std::string> arguments =
+    {
+        "ls_type_program",
+        "-A",
+        "-P",
+        "Foo",
+        "--PATTERN=Bar",
+        "--color",
+        "Red",
+        "-s",
+        "20",
+        "file1"
+    };
+
+    try
+    {
+        parser.ParseArguments(arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        std::cout << "Error parsing program options: " << e.what() << std::endl;
+        STF_ASSERT_TRUE(false);
+    }
+
+    // Ensure parameter counts are as expected
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("color"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("size"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount(""));
+
+    // Values retain the case given by the user
+    std::vector<std::string> patterns = parser.GetOptionStrings("pattern");
+    STF_ASSERT_EQ(std::string("Foo"), patterns[0]);
+    STF_ASSERT_EQ(std::string("Bar"), patterns[1]);
+    STF_ASSERT_EQ(std::string("Red"), parser.GetOptionString("color"));
+
+    // The same input is rejected when matching is case sensitive
+    Terra::ProgramOptions::Parser sensitive_parser(options);
+    bool exception_caught = false;
+
+    try
+    {
+        sensitive_parser.ParseArguments(arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                        Terra::ProgramOptions::OptionsError::InvalidShortOption)
+        {
+            exception_caught = true;
+        }
+    }
+
+    STF_ASSERT_TRUE(exception_caught);
+}
+
+// Test case insensitive matching of non-ASCII long options
+STF_TEST(ProgramOptions, TestCaseInsensitiveUTF8)
+{
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long          Multi  Argument
+        { "change",    "",    "ändern",     false, true  },
+        { "speed",     "",    "скорость",   false, true  },
+        { "alpha",     "",    "Αλφα",       false, false }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser;
+    parser.SetOptions(options, {"-"}, {"--"}, "=", true);
+
+    // Simulate command-line arguments
+    const std::vector<std::string> arguments =
+    {
+        "program",
+        "--ÄNDERN=Ä",
+        "--СКОРОСТЬ",
+        "10",
+        "--αΛΦΑ"
+    };
+
+    try
+    {
+        parser.ParseArguments(arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        std::cout << "Error parsing program options: " << e.what() << std::endl;
+        STF_ASSERT_TRUE(false);
+    }
+
+    STF_ASSERT_EQ(std::string("Ä"), parser.GetOptionString("change"));
+    STF_ASSERT_EQ(std::string("10"), parser.GetOptionString("speed"));
+    STF_ASSERT_TRUE(parser.OptionGiven("alpha"));
+}
+
+// Test the BasicParser using the default policy
+STF_TEST(ProgramOptions, TestBasicParserDefaultPolicy)
+{
+    Terra::ProgramOptions::BasicParser<> parser(GetCommandParser());
+
+    // Simulate command-line arguments
+    const int argc = 11;
+    const char *argv[] =
+    {
+        "ls_type_program",
+        "-ap",
+        "foo",
+        "file1",
+        "--pattern=bar",
+        "--color",
+        "red",
+        "--min-size",
+        "20",
+        "--",
+        "-"
+    };
+
+    try
+    {
+        parser.ParseArguments(argc, argv);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        std::cout << "Error parsing program options: " << e.what() << std::endl;
+        STF_ASSERT_TRUE(false);
+    }
+
+    // Ensure parameter counts are as expected
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("color"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("size"));
+    STF_ASSERT_EQ(std::size_t(3), parser.GetOptionCount(""));
+
+    std::vector<std::string> patterns = parser.GetOptionStrings("pattern");
+    STF_ASSERT_EQ(std::string("foo"), patterns[0]);
+    STF_ASSERT_EQ(std::string("bar"), patterns[1]);
+
+    std::vector<std::string> strings = parser.GetOptionStrings("");
+    STF_ASSERT_EQ(std::string("file1"), strings[0]);
+    STF_ASSERT_EQ(std::string("--"), strings[1]);
+    STF_ASSERT_EQ(std::string("-"), strings[2]);
+}
+
+// Define a policy for DOS-style program options
+struct DOSPolicy
+{
+    static constexpr bool case_insensitive = true;
+    static constexpr std::array<std::string_view, 0> short_flags{};
+    static constexpr std::array<std::string_view, 1> long_flags{"/"};
+    static constexpr std::string_view option_value_separator{":"};
+};
+
+// Test the BasicParser using a custom policy
+STF_TEST(ProgramOptions, TestBasicParserCustomPolicy)
+{
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name         Short    Long        Multi  Argument
+        { "attributes",  "",    "A",        false, true  },
+        { "bare",        "",    "B",        false, false },
+        { "sort",        "",    "O",        false, true  }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::BasicParser<DOSPolicy> parser;
+    parser.SetOptions(options);
+
+    const std::vector<std::string> arguments =
+    {
+        "dir",
+        "/a:D",
+        "/b",
+        "/O",
+        "N",
+        "-x"
+    };
+
+    try
+    {
+        parser.ParseArguments(arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        std::cout << "Error parsing program options: " << e.what() << std::endl;
+        STF_ASSERT_TRUE(false);
+    }
+
+    STF_ASSERT_EQ(std::string("D"), parser.GetOptionString("attributes"));
+    STF_ASSERT_TRUE(parser.OptionGiven("bare"));
+    STF_ASSERT_EQ(std::string("N"), parser.GetOptionString("sort"));
+    STF_ASSERT_EQ(std::string("-x"), parser.GetOptionString(""));
+
+    // An unknown option is rejected
+    bool exception_caught = false;
+
+    try
+    {
+        parser.ClearOptions();
+        parser.ParseArguments(std::vector<std::string>{"dir", "/Q"});
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                        Terra::ProgramOptions::OptionsError::InvalidLongOption)
+        {
+            exception_caught = true;
+        }
+    }
+
+    STF_ASSERT_TRUE(exception_caught);
+
+    // The flags of the policy may not be replaced via the Parser
+    Terra::ProgramOptions::Parser &base = parser;
+    exception_caught = false;
+    try
+    {
+        base.SetOptions(options);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        exception_caught =
+            e.options_error == Terra::ProgramOptions::OptionsError::FlagConflict;
+    }
+    STF_ASSERT_TRUE(exception_caught);
+    base.SetOptions(options, {}, {"/"}, ":", true);
+
+    // Unknown options are recognized using the flags of the policy
+    parser.SetUnknownOptions(
+        Terra::ProgramOptions::UnknownOptions::PassThroughWithValues);
+    parser.ParseArguments(
+        std::vector<std::string>{"dir", "/Q", "-x", "/R", "/b"});
+    STF_ASSERT_TRUE((std::vector<std::size_t>{1, 2, 3} ==
+                     std::vector<std::size_t>(
+                         parser.GetUnknownPositions().begin(),
+                         parser.GetUnknownPositions().end())));
+    STF_ASSERT_TRUE(parser.OptionGiven("bare"));
+
+    // Options are appended using the flags of the policy
+    Terra::ProgramOptions::ArgumentVector child;
+    parser.AppendOptions(child);
+    STF_ASSERT_EQ(std::size_t(1), child.Size());
+    STF_ASSERT_EQ(std::string_view("/B"), child[0]);
+}
+
+// Test parsing arguments given as various kinds of ranges
+STF_TEST(ProgramOptions, TestParseRanges)
+{
+    Terra::ProgramOptions::Parser parser(GetCommandParser());
+
+    // Check the results common to each of the ranges parsed below
+    auto check_results = [&]()
+    {
+        STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+        STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+        STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("color"));
+        STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount(""));
+
+        std::vector<std::string> patterns = parser.GetOptionStrings("pattern");
+        STF_ASSERT_EQ(std::string("foo"), patterns[0]);
+        STF_ASSERT_EQ(std::string("bar"), patterns[1]);
+        STF_ASSERT_EQ(std::string("red"), parser.GetOptionString("color"));
+
+        std::vector<std::string> strings = parser.GetOptionStrings("");
+        STF_ASSERT_EQ(std::string("file1"), strings[0]);
+        STF_ASSERT_EQ(std::string("-"), strings[1]);
+    };
+
+    // A span of mutable C strings, as given to main()
+    char program[] = "program";
+    char all_pattern[] = "-ap";
+    char foo[] = "foo";
+    char file1[] = "file1";
+    char pattern[] = "--pattern=bar";
+    char color[] = "--color";
+    char red[] = "red";
+    char dash[] = "-";
+    char *argv[] = {program, all_pattern, foo, file1, pattern, color, red, dash};
+
+    parser.ParseArguments(std::span<char *>(argv));
+    check_results();
+
+    // A list of strings
+    const std::list<std::string> list =
+    {
+        "program", "-ap", "foo", "file1", "--pattern=bar", "--color", "red", "-"
+    };
+
+    parser.ClearOptions();
+    parser.ParseArguments(list);
+    check_results();
+
+    // Concatenated segments of arguments, where an option's parameter is
+    // found in the following segment
+    const std::vector<std::vector<std::string>> segments =
+    {
+        {"program", "-ap"},
+        {"foo", "file1", "--pattern=bar", "--color"},
+        {},
+        {"red", "-"}
+    };
+
+    parser.ClearOptions();
+    parser.ParseArguments(segments | std::views::join);
+    check_results();
+
+    // A single-pass range read from a stream
+    std::istringstream stream("program -ap foo file1 --pattern=bar --color "
+                              "red -");
+
+    parser.ClearOptions();
+    parser.ParseArguments(std::views::istream<std::string>(stream));
+    check_results();
+
+    // Ranges having no arguments beyond the command name
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string_view>{});
+    parser.ParseArguments(std::span<char *>(argv, 1));
+    STF_ASSERT_FALSE(parser.OptionGiven(""));
+
+    // An option expecting a parameter at the end of the range
+    bool exception_caught = false;
+    try
+    {
+        parser.ClearOptions();
+        parser.ParseArguments(std::span<char *>(argv, 6));
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                    Terra::ProgramOptions::OptionsError::MissingOptionArgument)
+        {
+            exception_caught = true;
+        }
+    }
+    STF_ASSERT_TRUE(exception_caught);
+}
+
+// Test retrieving views of option strings and taking option strings
+STF_TEST(ProgramOptions, TestOptionStringViews)
+{
+    Terra::ProgramOptions::Parser parser(GetCommandParser());
+    const std::vector<std::string> arguments =
+    {
+        "program", "-p", "foo", "--pattern=bar", "--color", "red", "file1"
+    };
+
+    parser.ParseArguments(arguments);
+
+    // Views refer to the strings held by the parser
+    const Terra::ProgramOptions::Parser &const_parser = parser;
+    STF_ASSERT_EQ(std::string_view("red"),
+                  const_parser.GetOptionStringView("color"));
+
+    std::span<const std::string> patterns =
+                                    const_parser.GetOptionStringsView("pattern");
+    STF_ASSERT_EQ(std::size_t(2), patterns.size());
+    STF_ASSERT_EQ(std::string("foo"), patterns[0]);
+    STF_ASSERT_EQ(std::string("bar"), patterns[1]);
+    STF_ASSERT_EQ(patterns.data(),
+                  const_parser.GetOptionStringsView("pattern").data());
+
+    // Taking the strings transfers them to the caller
+    std::vector<std::string> taken = parser.TakeOptionStrings("pattern");
+    STF_ASSERT_EQ(std::size_t(2), taken.size());
+    STF_ASSERT_EQ(std::string("bar"), taken[1]);
+    STF_ASSERT_FALSE(parser.OptionGiven("pattern"));
+    STF_ASSERT_EQ(std::string("file1"), parser.GetOptionString(""));
+
+    // Views and take behave like the other getters for absent options
+    bool exception_caught = false;
+    try
+    {
+        parser.GetOptionStringsView("pattern");
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                        Terra::ProgramOptions::OptionsError::OptionNotGiven)
+        {
+            exception_caught = true;
+        }
+    }
+    STF_ASSERT_TRUE(exception_caught);
+
+    exception_caught = false;
+    try
+    {
+        parser.TakeOptionStrings("size");
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                        Terra::ProgramOptions::OptionsError::OptionNotGiven)
+        {
+            exception_caught = true;
+        }
+    }
+    STF_ASSERT_TRUE(exception_caught);
+
+    // The option may be given again once arguments are parsed again
+    parser.ClearOptions();
+    parser.ParseArguments(arguments);
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+}
+
+// Test counting of options without values and retrieval of positions
+STF_TEST(ProgramOptions, TestOptionCountsAndPositions)
+{
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "all",       "a",   "all",      false, false },
+        { "verbose",   "v",   "verbose",  true,  false },
+        { "pattern",   "p",   "pattern",  true,  true  }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+    const std::vector<std::string> arguments =
+    {
+        "program", "-vv", "file1", "-p", "foo", "--verbose", "-av", "file2"
+    };
+
+    parser.ParseArguments(arguments);
+
+    // Options without values are counted
+    STF_ASSERT_EQ(std::size_t(4), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+
+    // Options without values are presented as empty strings
+    STF_ASSERT_EQ(std::string(), parser.GetOptionString("all"));
+    std::vector<std::string> verbose = parser.GetOptionStrings("verbose");
+    STF_ASSERT_EQ(std::size_t(4), verbose.size());
+    STF_ASSERT_TRUE(verbose[3].empty());
+
+    // No strings are stored for options without values, so views are empty
+    STF_ASSERT_TRUE(parser.GetOptionStringsView("verbose").empty());
+    STF_ASSERT_TRUE(parser.GetOptionStringView("all").empty());
+
+    // Positions refer to the argument specifying the option
+    STF_ASSERT_TRUE((std::pair<std::size_t, std::size_t>(1, 6) ==
+                     parser.GetOptionPositions("verbose")));
+    STF_ASSERT_TRUE((std::pair<std::size_t, std::size_t>(6, 6) ==
+                     parser.GetOptionPositions("all")));
+    STF_ASSERT_TRUE((std::pair<std::size_t, std::size_t>(3, 3) ==
+                     parser.GetOptionPositions("pattern")));
+    STF_ASSERT_TRUE((std::pair<std::size_t, std::size_t>(2, 7) ==
+                     parser.GetOptionPositions("")));
+
+    // Taking the strings of an option without values yields empty strings
+    STF_ASSERT_EQ(std::size_t(4), parser.TakeOptionStrings("verbose").size());
+    STF_ASSERT_FALSE(parser.OptionGiven("verbose"));
+
+    // Clearing resets counts
+    parser.ClearOptions();
+    STF_ASSERT_FALSE(parser.OptionGiven("all"));
+    STF_ASSERT_EQ(std::size_t(0), parser.GetOptionCount(""));
+
+    bool exception_caught = false;
+    try
+    {
+        parser.GetOptionPositions("all");
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                        Terra::ProgramOptions::OptionsError::OptionNotGiven)
+        {
+            exception_caught = true;
+        }
+    }
+    STF_ASSERT_TRUE(exception_caught);
+}
+
+// Test the two-pass parse strategy
+STF_TEST(ProgramOptions, TestTwoPassStrategy)
+{
+    Terra::ProgramOptions::Parser parser(GetCommandParser());
+    const std::vector<std::string> arguments =
+    {
+        "program", "-ap", "foo", "file1", "--pattern=bar", "--color", "red",
+        "-"
+    };
+    const std::vector<std::string> invalid_arguments =
+    {
+        "program", "-p", "foo", "--min-size=1", "--min-size=2"
+    };
+
+    parser.SetParseStrategy(Terra::ProgramOptions::ParseStrategy::TwoPass);
+
+    // The results are the same as for a single pass
+    parser.ParseArguments(arguments);
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+    STF_ASSERT_EQ(std::string("bar"), parser.GetOptionStrings("pattern")[1]);
+    STF_ASSERT_EQ(std::string("red"), parser.GetOptionString("color"));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount(""));
+
+    // Errors are reported as usual
+    bool exception_caught = false;
+    try
+    {
+        parser.ClearOptions();
+        parser.ParseArguments(invalid_arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        if (e.options_error ==
+                        Terra::ProgramOptions::OptionsError::MultipleInstances)
+        {
+            exception_caught = true;
+        }
+    }
+    STF_ASSERT_TRUE(exception_caught);
+
+    // Single-pass ranges are parsed in a single pass
+    std::istringstream stream("program -p foo file1");
+    parser.ClearOptions();
+    parser.ParseArguments(std::views::istream<std::string>(stream));
+    STF_ASSERT_EQ(std::string("foo"), parser.GetOptionString("pattern"));
+    STF_ASSERT_EQ(std::string("file1"), parser.GetOptionString(""));
+
+    // Reserving storage does not alter results
+    parser.ClearOptions();
+    parser.Reserve("pattern", 100);
+    parser.Reserve("all", 100);
+    parser.Reserve("unknown", 100);
+    parser.ParseArguments(arguments);
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+}
+
+// Test reusing a parser across ClearOptions() calls
+STF_TEST(ProgramOptions, TestClearOptionsReuse)
+{
+    Terra::ProgramOptions::Parser parser(GetCommandParser());
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-a", "-p", "foo", "-p", "bar", "file1"});
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+
+    // Nothing parsed previously remains visible after clearing
+    parser.ClearOptions();
+    STF_ASSERT_FALSE(parser.OptionGiven("all"));
+    STF_ASSERT_FALSE(parser.OptionGiven("pattern"));
+    STF_ASSERT_FALSE(parser.OptionGiven(""));
+
+    // Newly parsed values replace those previously stored
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "--pattern=baz", "--color", "red"});
+    STF_ASSERT_FALSE(parser.OptionGiven("all"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("pattern"));
+    STF_ASSERT_EQ(std::string("baz"), parser.GetOptionString("pattern"));
+    STF_ASSERT_EQ(std::size_t(1),
+                  parser.GetOptionStringsView("pattern").size());
+    STF_ASSERT_TRUE((std::pair<std::size_t, std::size_t>(1, 1) ==
+                     parser.GetOptionPositions("pattern")));
+    STF_ASSERT_FALSE(parser.OptionGiven(""));
+
+    // Options allowed once may be given again after clearing
+    parser.ClearOptions();
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{"program", "-a", "-c", "x"});
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+    STF_ASSERT_EQ(std::string("x"), parser.GetOptionString("color"));
+
+    // Without clearing, values accumulate
+    parser.ParseArguments(std::vector<std::string>{"program", "-p", "q"});
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("all"));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("pattern"));
+}
+
+// Test options bound to variables
+STF_TEST(ProgramOptions, TestOptionBindings)
+{
+    struct Settings
+    {
+        bool all = false;
+        unsigned level = 0;
+        int verbosity = -1;
+        double ratio = 0.0;
+        std::string color;
+        std::vector<std::string> patterns;
+        std::vector<int> sizes;
+    } settings;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "all",       "a",   "all",      false, false,
+          Terra::ProgramOptions::Bind(settings.all) },
+        { "level",     "l",   "level",    false, true,
+          Terra::ProgramOptions::Bind(settings.level, 0u, 9u, 6u) },
+        { "verbose",   "v",   "verbose",  true,  false,
+          Terra::ProgramOptions::Bind(settings.verbosity, 0, 3, 0) },
+        { "ratio",     "r",   "ratio",    false, true,
+          Terra::ProgramOptions::Bind(settings.ratio) },
+        { "color",     "c",   "color",    false, true,
+          Terra::ProgramOptions::Bind(settings.color,
+                                      std::string("none")) },
+        { "pattern",   "p",   "pattern",  true,  true,
+          Terra::ProgramOptions::Bind(settings.patterns) },
+        { "size",      "s",   "size",     true,  true,
+          Terra::ProgramOptions::Bind(settings.sizes, -10, 10) },
+        { "unbound",   "u",   "unbound",  false, true  }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-avv", "--level=3", "-r", "0.25", "-p", "foo",
+        "-s", "-2", "-u", "x", "--pattern=bar", "-s", "7", "file"});
+
+    STF_ASSERT_TRUE(settings.all);
+    STF_ASSERT_EQ(3u, settings.level);
+    STF_ASSERT_EQ(2, settings.verbosity);
+    STF_ASSERT_EQ(0.25, settings.ratio);
+    STF_ASSERT_EQ(std::string("none"), settings.color);
+    STF_ASSERT_EQ(std::size_t(2), settings.patterns.size());
+    STF_ASSERT_EQ(std::string("foo"), settings.patterns[0]);
+    STF_ASSERT_EQ(std::string("bar"), settings.patterns[1]);
+    STF_ASSERT_TRUE((std::vector<int>{-2, 7} == settings.sizes));
+
+    // Bound options are counted, but no strings are retained
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("pattern"));
+    try
+    {
+        parser.GetOptionStringsView("pattern");
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::ValueTypeMismatch,
+                      e.options_error);
+    }
+    STF_ASSERT_EQ(std::string("x"), parser.GetOptionString("unbound"));
+    STF_ASSERT_EQ(std::string("file"), parser.GetOptionString(""));
+
+    // Defaults are assigned to options not given and vectors are replaced
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "--color", "red", "-s", "1"});
+    STF_ASSERT_EQ(6u, settings.level);
+    STF_ASSERT_EQ(0, settings.verbosity);
+    STF_ASSERT_EQ(std::string("red"), settings.color);
+    STF_ASSERT_TRUE((std::vector<int>{1} == settings.sizes));
+    STF_ASSERT_TRUE(settings.patterns.empty());
+
+    // Values that are invalid or out of range are rejected while parsing
+    const std::vector<std::vector<std::string>> invalid =
+    {
+        {"program", "--level=10"},
+        {"program", "--level=-1"},
+        {"program", "--level=3x"},
+        {"program", "--level="},
+        {"program", "--ratio=abc"},
+        {"program", "-s", "11"},
+        {"program", "-vvvv"}
+    };
+    for (const auto &arguments : invalid)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(arguments);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_TRUE(
+                (e.options_error ==
+                 Terra::ProgramOptions::OptionsError::OptionValueError) ||
+                (e.options_error ==
+                 Terra::ProgramOptions::OptionsError::MissingOptionArgument));
+        }
+    }
+
+    // The error message describes the valid range
+    parser.ClearOptions();
+    try
+    {
+        parser.ParseArguments(std::vector<std::string>{"program", "-l", "12"});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(std::string("Argument value for \"level\" is "
+                                  "out-of-range: 12 [valid range is 0 .. 9]"),
+                      std::string(e.what()));
+    }
+
+    // Options without values must be bound to bool or integral variables
+    std::string name;
+    Terra::ProgramOptions::Parser checked;
+    try
+    {
+        checked.SetOptions({{"name", "n", "name", false, false,
+                             Terra::ProgramOptions::Bind(name)}});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidBinding,
+                      e.options_error);
+    }
+}
+
+// Test conversion of bound values of various types
+STF_TEST(ProgramOptions, TestBoundValueConversion)
+{
+    bool flag = false;
+    std::int8_t small = 0;
+    std::uint64_t large = 0;
+    float ratio = 0.0f;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "flag",      "f",   "flag",     true,  true,
+          Terra::ProgramOptions::Bind(flag) },
+        { "small",     "s",   "small",    true,  true,
+          Terra::ProgramOptions::Bind(small) },
+        { "large",     "l",   "large",    true,  true,
+          Terra::ProgramOptions::Bind(large) },
+        { "ratio",     "r",   "ratio",    true,  true,
+          Terra::ProgramOptions::Bind(ratio, -1.0f, 1.0f) }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-f", "YES", "-s", "-128", "-l", "18446744073709551615",
+        "-r", "-0.5"});
+    STF_ASSERT_TRUE(flag);
+    STF_ASSERT_EQ(std::int8_t(-128), small);
+    STF_ASSERT_EQ(std::uint64_t(18446744073709551615ULL), large);
+    STF_ASSERT_EQ(-0.5f, ratio);
+
+    // A later value replaces an earlier one
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-f", "on", "-f", "Off", "-s", "1", "-s", "2"});
+    STF_ASSERT_FALSE(flag);
+    STF_ASSERT_EQ(std::int8_t(2), small);
+
+    // Values outside the range of the type are rejected
+    const std::vector<std::vector<std::string>> invalid =
+    {
+        {"program", "-f", "maybe"},
+        {"program", "-s", "128"},
+        {"program", "-l", "18446744073709551616"},
+        {"program", "-l", "-1"},
+        {"program", "-l", " 1"},
+        {"program", "-r", "1.5"},
+        {"program", "-r", "nan"}
+    };
+    for (const auto &arguments : invalid)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(arguments);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                          e.options_error);
+        }
+    }
+}
+
+// Test options having typed values
+STF_TEST(ProgramOptions, TestTypedValues)
+{
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "offset",    "o",   "offset",   true,  true,  {},
+          ValueType::Integer, {.integer_min = -100, .integer_max = 100} },
+        { "count",     "n",   "count",    false, true,  {},
+          ValueType::Unsigned },
+        { "ratio",     "r",   "ratio",    true,  true,  {},
+          ValueType::Floating, {.floating_min = -1.0, .floating_max = 1.0} },
+        { "enable",    "e",   "enable",   true,  true,  {},
+          ValueType::Boolean },
+        { "name",      "N",   "name",     false, true  }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-o", "-5", "--offset=42", "-n", "18446744073709551615",
+        "-r", "-0.5", "-r", "1", "-e", "yes", "--enable=False", "-N", "x"});
+
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("offset"));
+    std::span<const std::int64_t> offsets = parser.GetOptionIntegers("offset");
+    STF_ASSERT_EQ(std::size_t(2), offsets.size());
+    STF_ASSERT_EQ(std::int64_t(-5), offsets[0]);
+    STF_ASSERT_EQ(std::int64_t(42), offsets[1]);
+    STF_ASSERT_EQ(std::uint64_t(18446744073709551615ULL),
+                  parser.GetOptionUnsignedIntegers("count").front());
+    std::span<const double> ratios = parser.GetOptionFloats("ratio");
+    STF_ASSERT_EQ(std::size_t(2), ratios.size());
+    STF_ASSERT_EQ(-0.5, ratios[0]);
+    STF_ASSERT_EQ(1.0, ratios[1]);
+    STF_ASSERT_TRUE((std::vector<bool>{true, false} ==
+                     parser.GetOptionBooleans("enable")));
+    STF_ASSERT_EQ(std::string("x"), parser.GetOptionString("name"));
+
+    // Numeric getters convert from the typed values
+    std::vector<int> int_values;
+    parser.GetOptionValues("offset", int_values);
+    STF_ASSERT_TRUE((std::vector<int>{-5, 42} == int_values));
+    double ratio = 0.0;
+    parser.GetOptionValue("ratio", ratio);
+    STF_ASSERT_EQ(-0.5, ratio);
+    unsigned enable = 0;
+    parser.GetOptionValue("enable", enable);
+    STF_ASSERT_EQ(1u, enable);
+
+    // Conversion to a type unable to hold a value is reported
+    try
+    {
+        unsigned count = 0;
+        parser.GetOptionValue("count", count);
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                      e.options_error);
+    }
+    try
+    {
+        std::vector<int> values;
+        parser.GetOptionValues("offset", values, 0, 10);
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                      e.options_error);
+    }
+
+    // Requesting values of the wrong type is an error
+    try
+    {
+        parser.GetOptionFloats("offset");
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::ValueTypeMismatch,
+                      e.options_error);
+    }
+
+    // Invalid values are rejected while parsing
+    const std::vector<std::vector<std::string>> invalid =
+    {
+        {"program", "-o", "101"},
+        {"program", "-o", "1.5"},
+        {"program", "-n", "-1"},
+        {"program", "-r", "1.01"},
+        {"program", "-e", "2"}
+    };
+    for (const auto &arguments : invalid)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(arguments);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                          e.options_error);
+        }
+    }
+
+    // Values from an earlier parse are not visible once cleared
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{"program", "-o", "7"});
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionIntegers("offset").size());
+    STF_ASSERT_FALSE(parser.OptionGiven("ratio"));
+
+    // Typed values must be declared only for options expecting a value
+    Terra::ProgramOptions::Parser checked;
+    try
+    {
+        checked.SetOptions({{"flag", "f", "flag", false, false, {},
+                             ValueType::Integer}});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidValueType,
+                      e.options_error);
+    }
+}
+
+STF_TEST(ProgramOptions, TestChoices)
+{
+    using Terra::ProgramOptions::ValueType;
+
+    enum class Compression { None, Fast, Best };
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "compress",  "c",   "compress", false, true,  {},
+          ValueType::String, {}, {"none", "fast", "best"} },
+        { "color",     "C",   "color",    true,  true,  {},
+          ValueType::String, {}, {"red", "green", "blue", "cyan", "magenta",
+                                  "yellow", "black", "white", "orange"} }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "--compress=best", "-C", "orange", "-C", "red",
+        "--color", "white"});
+
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionChoice("compress"));
+    STF_ASSERT_TRUE(Compression::Best ==
+                    parser.GetOptionChoice<Compression>("compress"));
+    std::span<const std::uint32_t> colors = parser.GetOptionChoices("color");
+    STF_ASSERT_EQ(std::size_t(3), colors.size());
+    STF_ASSERT_EQ(std::uint32_t(8), colors[0]);
+    STF_ASSERT_EQ(std::uint32_t(0), colors[1]);
+    STF_ASSERT_EQ(std::uint32_t(7), colors[2]);
+
+    // Numeric getters return the indices and no strings are retained
+    int compress = 0;
+    parser.GetOptionValue("compress", compress);
+    STF_ASSERT_EQ(2, compress);
+    try
+    {
+        parser.GetOptionStringsView("color");
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::ValueTypeMismatch,
+                      e.options_error);
+    }
+
+    // Each choice is matched, while other values (including prefixes and
+    // values differing in case) are rejected
+    for (std::size_t i = 0; i < options[1].choices.size(); i++)
+    {
+        parser.ClearOptions();
+        parser.ParseArguments(std::vector<std::string>{
+            "program", "-C", options[1].choices[i]});
+        STF_ASSERT_EQ(i, parser.GetOptionChoice("color"));
+    }
+    const std::vector<std::string> invalid = {"", "re", "redd", "Red", "x"};
+    for (const auto &value : invalid)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(
+                        std::vector<std::string>{"program", "-C", value});
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidChoice,
+                          e.options_error);
+        }
+    }
+
+    // A choice listed more than once matches its first listing
+    Terra::ProgramOptions::Options repeated_options =
+    {
+        { "level", "l", "level", false, true }
+    };
+    repeated_options[0].choices = {"low", "high", "low", "LOW", "off"};
+    Terra::ProgramOptions::Parser repeated(repeated_options);
+    repeated.ParseArguments(std::vector<std::string>{"program", "-l", "low"});
+    STF_ASSERT_EQ(std::uint32_t(0), repeated.GetOptionChoice("level"));
+    repeated.ClearOptions();
+    repeated.ParseArguments(std::vector<std::string>{"program", "-l", "LOW"});
+    STF_ASSERT_EQ(std::uint32_t(3), repeated.GetOptionChoice("level"));
+    repeated.ClearOptions();
+    repeated.ParseArguments(std::vector<std::string>{"program", "-l", "off"});
+    STF_ASSERT_EQ(std::uint32_t(4), repeated.GetOptionChoice("level"));
+    Terra::ProgramOptions::Parser repeated_folded(repeated_options,
+                                                  {"-"},
+                                                  {"--"},
+                                                  "=",
+                                                  true);
+    repeated_folded.ParseArguments(
+                    std::vector<std::string>{"program", "-l", "LOW"});
+    STF_ASSERT_EQ(std::uint32_t(0), repeated_folded.GetOptionChoice("level"));
+
+    // Choices are matched case insensitively if options are
+    Terra::ProgramOptions::Parser folded(options, {"-"}, {"--"}, "=", true);
+    folded.ParseArguments(
+                std::vector<std::string>{"program", "--COMPRESS=Fast"});
+    STF_ASSERT_TRUE(Compression::Fast ==
+                    folded.GetOptionChoice<Compression>("compress"));
+
+    // Requesting choices of an option without choices is an error
+    Terra::ProgramOptions::Parser plain(
+                        {{"name", "n", "name", false, true}});
+    plain.ParseArguments(std::vector<std::string>{"program", "-n", "x"});
+    try
+    {
+        plain.GetOptionChoice("name");
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::ValueTypeMismatch,
+                      e.options_error);
+    }
+
+    // Choices may be bound to an enumeration
+    Compression bound = Compression::None;
+    Terra::ProgramOptions::Parser binding(
+        {{"compress", "c", "compress", false, true,
+          Terra::ProgramOptions::BindChoice(bound, Compression::Fast),
+          ValueType::String, {}, {"none", "fast", "best"}}});
+    binding.ParseArguments(std::vector<std::string>{"program", "-c", "best"});
+    STF_ASSERT_TRUE(Compression::Best == bound);
+    binding.ClearOptions();
+    binding.ParseArguments(std::vector<std::string>{"program"});
+    STF_ASSERT_TRUE(Compression::Fast == bound);
+
+    // Choices must be distinct and given only for options expecting a value
+    const std::vector<Terra::ProgramOptions::Options> invalid_options =
+    {
+        {{"c", "c", "c", false, true, {}, ValueType::String, {}, {"a", "a"}}},
+        {{"c", "c", "c", false, false, {}, ValueType::String, {}, {"a"}}},
+        {{"c", "c", "c", false, true, {}, ValueType::Integer, {}, {"1"}}}
+    };
+    Terra::ProgramOptions::Parser checked;
+    for (const auto &specification : invalid_options)
+    {
+        try
+        {
+            checked.SetOptions(specification);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::SpecificationException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidValueType,
+                          e.options_error);
+        }
+    }
+    try
+    {
+        checked.SetOptions({{"c", "c", "c", false, true,
+                             Terra::ProgramOptions::BindChoice(bound)}});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidBinding,
+                      e.options_error);
+    }
+}
+
+STF_TEST(ProgramOptions, TestDelimitedLists)
+{
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "ids",       "i",   "ids",      true,  true,  {},
+          ValueType::Integer, {.integer_min = 0, .integer_max = 100},
+          {}, ',' },
+        { "tags",      "t",   "tags",     false, true,  {},
+          ValueType::String, {}, {}, ':' },
+        { "color",     "c",   "color",    false, true,  {},
+          ValueType::String, {}, {"red", "green", "blue"}, ',' }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "--ids=1,2,3", "-i", "42", "-t", "a::b",
+        "--color=blue,red"});
+
+    // Each instance is counted once, but each value is stored
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("ids"));
+    std::span<const std::int64_t> ids = parser.GetOptionIntegers("ids");
+    STF_ASSERT_EQ(std::size_t(4), ids.size());
+    STF_ASSERT_EQ(std::int64_t(1), ids[0]);
+    STF_ASSERT_EQ(std::int64_t(3), ids[2]);
+    STF_ASSERT_EQ(std::int64_t(42), ids[3]);
+    STF_ASSERT_TRUE((std::vector<std::string>{"a", "", "b"} ==
+                     parser.GetOptionStrings("tags")));
+    std::span<const std::uint32_t> colors = parser.GetOptionChoices("color");
+    STF_ASSERT_EQ(std::size_t(2), colors.size());
+    STF_ASSERT_EQ(std::uint32_t(2), colors[0]);
+    STF_ASSERT_EQ(std::uint32_t(0), colors[1]);
+
+    // Numeric getters convert each value, applying the given bounds
+    std::vector<unsigned> values;
+    parser.GetOptionValues("ids", values);
+    STF_ASSERT_TRUE((std::vector<unsigned>{1, 2, 3, 42} == values));
+    try
+    {
+        parser.GetOptionValues("ids", values, 0u, 10u);
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                      e.options_error);
+    }
+
+    // Invalid values are reported with their position in the list
+    const std::vector<std::pair<std::string,
+                                Terra::ProgramOptions::OptionsError>> invalid =
+    {
+        {"--ids=1,x,3",
+         Terra::ProgramOptions::OptionsError::OptionValueError},
+        {"--ids=1,2,101",
+         Terra::ProgramOptions::OptionsError::OptionValueError},
+        {"--ids=1,",
+         Terra::ProgramOptions::OptionsError::OptionValueError},
+        {"--color=red,pink",
+         Terra::ProgramOptions::OptionsError::InvalidChoice}
+    };
+    const std::vector<std::string> positions = {"2", "3", "2", "2"};
+    for (std::size_t i = 0; i < invalid.size(); i++)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(
+                std::vector<std::string>{"program", invalid[i].first});
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(invalid[i].second, e.options_error);
+            STF_ASSERT_NE(std::string::npos,
+                          std::string(e.what()).find("(list element " +
+                                                     positions[i] + ")"));
+        }
+    }
+
+    // Lists are split when storing values in two passes and when bound
+    std::vector<int> bound;
+    Terra::ProgramOptions::Parser two_pass(
+        {{"ids", "i", "ids", true, true, Terra::ProgramOptions::Bind(bound),
+          ValueType::String, {}, {}, ','}});
+    two_pass.SetParseStrategy(Terra::ProgramOptions::ParseStrategy::TwoPass);
+    two_pass.ParseArguments(
+                std::vector<std::string>{"program", "-i", "5,6", "-i", "7"});
+    STF_ASSERT_TRUE((std::vector<int>{5, 6, 7} == bound));
+
+    // A delimiter may only be given for options expecting a value
+    Terra::ProgramOptions::Parser checked;
+    try
+    {
+        checked.SetOptions({{"flag", "f", "flag", false, false, {},
+                             ValueType::String, {}, {}, ','}});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidValueType,
+                      e.options_error);
+    }
+}
+
+STF_TEST(ProgramOptions, TestIntervalSets)
+{
+    using Terra::ProgramOptions::Interval;
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "cpus",      "c",   "cpus",     true,  true,  {},
+          ValueType::IntervalSet, {.unsigned_max = 1023} }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "--cpus=32-47,0-15", "-c", "16-20,100", "-c", "40-50,99"});
+
+    // Overlapping and adjacent ranges are merged and sorted
+    Terra::ProgramOptions::IntervalSet cpus = parser.GetOptionIntervals("cpus");
+    const std::vector<Interval> expected = {{0, 20}, {32, 50}, {99, 100}};
+    STF_ASSERT_EQ(expected.size(), cpus.Size());
+    STF_ASSERT_TRUE(std::equal(expected.begin(),
+                               expected.end(),
+                               cpus.Intervals().begin()));
+
+    STF_ASSERT_TRUE(cpus.Contains(0));
+    STF_ASSERT_TRUE(cpus.Contains(20));
+    STF_ASSERT_FALSE(cpus.Contains(21));
+    STF_ASSERT_FALSE(cpus.Contains(31));
+    STF_ASSERT_TRUE(cpus.Contains(45));
+    STF_ASSERT_TRUE(cpus.Contains(99));
+    STF_ASSERT_FALSE(cpus.Contains(101));
+
+    // Interval sets are not expanded by the numeric getters
+    try
+    {
+        std::vector<unsigned> values;
+        parser.GetOptionValues("cpus", values);
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::ValueTypeMismatch,
+                      e.options_error);
+    }
+
+    // Invalid values and ranges are rejected
+    const std::vector<std::string> invalid =
+    {
+        "--cpus=5-3", "--cpus=1-", "--cpus=-1", "--cpus=1,,2", "--cpus=1024",
+        "--cpus=0-x"
+    };
+    for (const auto &argument : invalid)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(
+                        std::vector<std::string>{"program", argument});
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                          e.options_error);
+        }
+    }
+
+    // A list having an invalid element leaves earlier intervals unchanged
+    parser.ClearOptions();
+    try
+    {
+        parser.ParseArguments(std::vector<std::string>{
+            "program", "--cpus=8,2", "--cpus=4,6-5"});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::OptionValueError,
+                      e.options_error);
+    }
+    const std::vector<Interval> retained = {{2, 2}, {8, 8}};
+    cpus = parser.GetOptionIntervals("cpus");
+    STF_ASSERT_EQ(retained.size(), cpus.Size());
+    STF_ASSERT_TRUE(std::equal(retained.begin(),
+                               retained.end(),
+                               cpus.Intervals().begin()));
+
+    // Intervals at the limits of the value type are merged
+    std::vector<Interval> intervals;
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    Terra::ProgramOptions::InsertInterval(intervals, {max, max});
+    Terra::ProgramOptions::InsertInterval(intervals, {0, 0});
+    Terra::ProgramOptions::InsertInterval(intervals, {2, max - 1});
+    STF_ASSERT_EQ(std::size_t(2), intervals.size());
+    Terra::ProgramOptions::InsertInterval(intervals, {1, 1});
+    STF_ASSERT_EQ(std::size_t(1), intervals.size());
+    STF_ASSERT_TRUE((Interval{0, max} == intervals.front()));
+
+    // Unsorted intervals are merged into sorted intervals at once
+    intervals = {{0, 3}, {10, 12}, {max, max}, {20, 20}, {4, 4}, {11, 15}};
+    Terra::ProgramOptions::MergeIntervals(intervals, 3);
+    STF_ASSERT_TRUE((std::vector<Interval>{{0, 4}, {10, 15}, {20, 20},
+                                           {max, max}} == intervals));
+
+    // Interval sets may name the comma as a value delimiter, but no other
+    Terra::ProgramOptions::Options delimited = options;
+    delimited[0].value_delimiter = ',';
+    Terra::ProgramOptions::Parser comma_parser(delimited);
+    comma_parser.ParseArguments(
+                std::vector<std::string>{"program", "--cpus=9,0-3,4"});
+    STF_ASSERT_EQ(std::size_t(2),
+                  comma_parser.GetOptionIntervals("cpus").Size());
+
+    delimited[0].value_delimiter = ':';
+    try
+    {
+        comma_parser.SetOptions(delimited);
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidValueType,
+                      e.options_error);
+    }
+}
+
+STF_TEST(ProgramOptions, TestMapOptions)
+{
+    using Terra::ProgramOptions::DuplicateKeys;
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "define",    "D",   "define",   true,  true,  {},
+          ValueType::Map },
+        { "header",    "H",   "header",   true,  true,  {},
+          ValueType::Map, {}, {}, '\0', ':', DuplicateKeys::Collect },
+        { "label",     "l",   "label",    true,  true,  {},
+          ValueType::Map, {}, {}, ',', '=', DuplicateKeys::Error }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-D", "name=value", "-D", "DEBUG", "--define=name=other",
+        "-D", "empty=", "-H", "Accept:text/html", "-H", "Accept:*/*",
+        "-H", "Host:example.com", "--label=a=1,b=2"});
+
+    // The last value given for a key is kept by default
+    const Terra::ProgramOptions::OptionMap &defines =
+                                                parser.GetOptionMap("define");
+    STF_ASSERT_EQ(std::size_t(3), defines.Size());
+    STF_ASSERT_EQ(std::string_view("other"), *defines.Find("name"));
+    STF_ASSERT_EQ(std::string_view(), *defines.Find("DEBUG"));
+    STF_ASSERT_EQ(std::string_view(), *defines.Find("empty"));
+    STF_ASSERT_TRUE(defines.Contains("empty"));
+    STF_ASSERT_FALSE(defines.Find("missing").has_value());
+    STF_ASSERT_EQ(std::size_t(0), defines.Count("missing"));
+
+    // Collected values are presented in the order given
+    const Terra::ProgramOptions::OptionMap &headers =
+                                                parser.GetOptionMap("header");
+    STF_ASSERT_EQ(std::size_t(2), headers.Size());
+    STF_ASSERT_EQ(std::size_t(2), headers.Count("Accept"));
+    std::vector<std::string_view> accept;
+    for (const auto value : headers.FindAll("Accept")) accept.push_back(value);
+    STF_ASSERT_TRUE((std::vector<std::string_view>{"text/html", "*/*"} ==
+                     accept));
+    std::vector<std::string> pairs;
+    headers.ForEach(
+        [&](std::string_view key, std::string_view value)
+        {
+            pairs.push_back(std::string(key) + "=" + std::string(value));
+        });
+    STF_ASSERT_TRUE((std::vector<std::string>{"Accept=text/html",
+                                              "Accept=*/*",
+                                              "Host=example.com"} == pairs));
+
+    // Pairs may be given as a delimited list
+    STF_ASSERT_EQ(std::string_view("2"),
+                  *parser.GetOptionMap("label").Find("b"));
+
+    // Many keys remain accessible as the table grows
+    parser.ClearOptions();
+    std::vector<std::string> arguments = {"program"};
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        arguments.push_back("-D");
+        arguments.push_back("key" + std::to_string(i) + "=" +
+                            std::to_string(i * 2));
+    }
+    parser.ParseArguments(arguments);
+    STF_ASSERT_EQ(std::size_t(1'000), parser.GetOptionMap("define").Size());
+    for (std::size_t i = 0; i < 1'000; i++)
+    {
+        STF_ASSERT_EQ(std::to_string(i * 2),
+                      std::string(*parser.GetOptionMap("define").Find(
+                                    "key" + std::to_string(i))));
+    }
+    STF_ASSERT_FALSE(parser.OptionGiven("header"));
+
+    // Duplicate keys and empty keys are rejected as configured
+    const std::vector<std::pair<std::string,
+                                Terra::ProgramOptions::OptionsError>> invalid =
+    {
+        {"--label=a=1,a=2", Terra::ProgramOptions::OptionsError::DuplicateKey},
+        {"--define==value",
+         Terra::ProgramOptions::OptionsError::OptionValueError}
+    };
+    for (const auto &[argument, error] : invalid)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(
+                        std::vector<std::string>{"program", argument});
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(error, e.options_error);
+        }
+    }
+}
+
+STF_TEST(ProgramOptions, TestDeduplicatedValues)
+{
+    using Terra::ProgramOptions::Deduplicate;
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "exclude",   "x",   "exclude",  true,  true,  {},
+          ValueType::String, {}, {}, ',', '=', {}, Deduplicate::Exact },
+        { "host",      "H",   "host",     true,  true,  {},
+          ValueType::String, {}, {}, '\0', '=', {}, Deduplicate::CaseFolded },
+        { "color",     "c",   "color",    true,  true,  {},
+          ValueType::String, {}, {"red", "green", "blue"}, '\0', '=', {},
+          Deduplicate::Exact },
+        { "pattern",   "p",   "pattern",  true,  true  }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-x", "b,a,b", "-x", "c", "--exclude=a,B,c",
+        "-H", "Example.COM", "-H", "example.com", "-H", "Ünïcödé.example",
+        "-H", "ÜNÏCÖDÉ.EXAMPLE", "-c", "blue", "-c", "red", "-c", "blue",
+        "-p", "a", "-p", "a"});
+
+    // Values are kept in the order first given, while every instance is
+    // counted
+    STF_ASSERT_EQ(std::size_t(3), parser.GetOptionCount("exclude"));
+    STF_ASSERT_TRUE((std::vector<std::string>{"b", "a", "c", "B"} ==
+                     parser.GetOptionStrings("exclude")));
+    STF_ASSERT_EQ(std::size_t(4), parser.GetOptionCount("host"));
+    STF_ASSERT_TRUE((std::vector<std::string>{"Example.COM",
+                                              "Ünïcödé.example"} ==
+                     parser.GetOptionStrings("host")));
+    std::span<const std::uint32_t> colors = parser.GetOptionChoices("color");
+    STF_ASSERT_EQ(std::size_t(2), colors.size());
+    STF_ASSERT_EQ(std::uint32_t(2), colors[0]);
+    STF_ASSERT_EQ(std::uint32_t(0), colors[1]);
+
+    // Options that do not deduplicate keep every value
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionStrings("pattern").size());
+
+    // Many unique values are indexed, and the index is reset when reused
+    for (std::size_t pass = 0; pass < 2; pass++)
+    {
+        parser.ClearOptions();
+        std::vector<std::string> arguments = {"program"};
+        for (std::size_t i = 0; i < 2'000; i++)
+        {
+            arguments.push_back("--exclude=value" + std::to_string(i % 500));
+        }
+        parser.ParseArguments(arguments);
+        const auto values = parser.GetOptionStringsView("exclude");
+        STF_ASSERT_EQ(std::size_t(500), values.size());
+        STF_ASSERT_EQ(std::string("value499"), values.back());
+    }
+
+    // Taken values are no longer considered when deduplicating
+    std::vector<std::string> taken = parser.TakeOptionStrings("exclude");
+    STF_ASSERT_EQ(std::size_t(500), taken.size());
+    parser.ParseArguments(std::vector<std::string>{"program", "-x", "value1"});
+    STF_ASSERT_TRUE((std::vector<std::string>{"value1"} ==
+                     parser.GetOptionStrings("exclude")));
+
+    // Only options storing strings or choices may deduplicate values
+    Terra::ProgramOptions::Parser checked;
+    try
+    {
+        checked.SetOptions({{"n", "n", "n", true, true, {},
+                             ValueType::Integer, {}, {}, '\0', '=', {},
+                             Deduplicate::Exact}});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::SpecificationException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::InvalidValueType,
+                      e.options_error);
+    }
+}
+
+STF_TEST(ProgramOptions, TestInternedValues)
+{
+    using Terra::ProgramOptions::Deduplicate;
+    using Terra::ProgramOptions::InternedValue;
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "queue",     "q",   "queue",    true,  true  },
+        { "fallback",  "f",   "fallback", false, true  },
+        { "exclude",   "x",   "exclude",  true,  true,  {},
+          ValueType::String, {}, {}, ',', '=', {}, Deduplicate::CaseFolded },
+        { "count",     "n",   "count",    false, true,  {},
+          ValueType::Integer },
+        { "level",     "l",   "level",    false, true  },
+        { "verbose",   "v",   "verbose",  false, false }
+    };
+    // clang-format on
+
+    auto table = std::make_shared<Terra::ProgramOptions::InternTable>();
+    Terra::ProgramOptions::Parser parser(options);
+    parser.SetInternTable(table);
+    STF_ASSERT_TRUE(parser.GetInternTable() == table);
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-q", "default", "-q", "batch", "-f", "default",
+        "-x", "a,A,b", "-n", "7", "-l", "3", "-v", "positional"});
+
+    // Identical values given for different options share a handle
+    std::span<const InternedValue> queues =
+                                    parser.GetOptionInternedValues("queue");
+    STF_ASSERT_EQ(std::size_t(2), queues.size());
+    STF_ASSERT_TRUE(queues[0] ==
+                    parser.GetOptionInternedValues("fallback").front());
+    STF_ASSERT_TRUE(queues[0] == table->Find("default"));
+    STF_ASSERT_TRUE(queues[1] == table->Find("batch"));
+    STF_ASSERT_EQ(std::string_view("batch"), table->View(queues[1]));
+    STF_ASSERT_FALSE(table->Find("positional").has_value());
+    STF_ASSERT_EQ(std::size_t(5), table->Size());
+
+    // String getters present the interned values
+    STF_ASSERT_TRUE((std::vector<std::string>{"default", "batch"} ==
+                     parser.GetOptionStrings("queue")));
+    STF_ASSERT_EQ(std::string("default"), parser.GetOptionString("fallback"));
+    STF_ASSERT_EQ(std::string_view("default"),
+                  parser.GetOptionStringView("fallback"));
+    STF_ASSERT_TRUE((std::vector<std::string>{"a", "b"} ==
+                     parser.GetOptionStrings("exclude")));
+    int level{};
+    parser.GetOptionValue("level", level);
+    STF_ASSERT_EQ(3, level);
+    std::int64_t count{};
+    parser.GetOptionValue("count", count);
+    STF_ASSERT_EQ(std::int64_t(7), count);
+    STF_ASSERT_TRUE(parser.OptionGiven("verbose"));
+    STF_ASSERT_EQ(std::string("positional"),
+                  parser.GetOptionStringsView("").front());
+
+    // The parser holds no strings for interned options
+    try
+    {
+        parser.GetOptionStringsView("queue");
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::ValueTypeMismatch,
+                      e.options_error);
+    }
+
+    // Copies share the table, so values are interned once across parses
+    Terra::ProgramOptions::Parser copy = parser;
+    copy.ClearOptions();
+    copy.ParseArguments(std::vector<std::string>{
+        "program", "-q", "batch", "-q", "urgent"});
+    STF_ASSERT_TRUE(copy.GetOptionInternedValues("queue").front() ==
+                    queues[1]);
+    STF_ASSERT_EQ(std::size_t(6), table->Size());
+
+    // Taken values are copied out and the option is no longer given
+    std::vector<std::string> taken = copy.TakeOptionStrings("queue");
+    STF_ASSERT_TRUE((std::vector<std::string>{"batch", "urgent"} == taken));
+    STF_ASSERT_FALSE(copy.OptionGiven("queue"));
+
+    // Results do not depend on whether values are interned
+    Terra::ProgramOptions::Parser plain(options);
+    plain.ParseArguments(std::vector<std::string>{
+        "program", "-q", "default", "-q", "batch", "-f", "default",
+        "-x", "a,A,b", "-n", "7", "-l", "3", "-v", "positional"});
+    STF_ASSERT_EQ(plain.GetFingerprint(), parser.GetFingerprint());
+
+    // Removing the table restores string storage
+    parser.SetInternTable(nullptr);
+    parser.ParseArguments(std::vector<std::string>{"program", "-q", "x"});
+    STF_ASSERT_EQ(std::string_view("x"),
+                  parser.GetOptionStringsView("queue").front());
+}
+
+STF_TEST(ProgramOptions, TestConstraints)
+{
+    using Terra::ProgramOptions::ConstraintType;
+    using Terra::ProgramOptions::OptionsError;
+
+    // Enough options that the presence bitset spans several words
+    Terra::ProgramOptions::Options options =
+    {
+        {"input",    "i", "input",    false, true },
+        {"output",   "o", "output",   false, true },
+        {"json",     "j", "json",     false, false},
+        {"xml",      "x", "xml",      false, false},
+        {"user",     "u", "user",     false, true },
+        {"password", "p", "password", false, true }
+    };
+    for (std::size_t i = 0; i < 100; i++)
+    {
+        options.push_back({"extra" + std::to_string(i),
+                           "",
+                           "extra" + std::to_string(i),
+                           false,
+                           false});
+    }
+    options.push_back({"last", "l", "last", false, false});
+
+    Terra::ProgramOptions::Parser parser(options);
+    const std::uint64_t unconstrained = parser.GetSpecFingerprint();
+
+    parser.SetConstraints({{ConstraintType::Required, {"input"}},
+                           {ConstraintType::Exclusive, {"json", "xml"}},
+                           {ConstraintType::Requires,
+                            {"user", "password", "last"}},
+                           {ConstraintType::Required, {"output"}}});
+    STF_ASSERT_NE(unconstrained, parser.GetSpecFingerprint());
+
+    // Satisfied constraints
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-i", "in", "-o", "out", "--json", "-u", "name",
+        "-p", "secret", "--last"});
+    STF_ASSERT_TRUE(parser.OptionGiven("user"));
+
+    // Each violation identifies the constraint and the options
+    const std::vector<std::pair<std::vector<std::string>,
+                                std::tuple<OptionsError,
+                                           std::size_t,
+                                           std::vector<std::string>>>> cases =
+    {
+        {{"program", "-o", "out"},
+         {OptionsError::MissingRequiredOption, 0, {"input"}}},
+        {{"program", "-i", "in"},
+         {OptionsError::MissingRequiredOption, 3, {"output"}}},
+        {{"program", "-i", "in", "-o", "out", "-x", "-j"},
+         {OptionsError::ConflictingOptions, 1, {"json", "xml"}}},
+        {{"program", "-i", "in", "-o", "out", "-u", "name", "--last"},
+         {OptionsError::MissingDependency, 2, {"password"}}}
+    };
+    for (const auto &[arguments, expected] : cases)
+    {
+        parser.ClearOptions();
+        try
+        {
+            parser.ParseArguments(arguments);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::ConstraintException &e)
+        {
+            STF_ASSERT_EQ(std::get<0>(expected), e.options_error);
+            STF_ASSERT_EQ(std::get<1>(expected), e.constraint_index);
+            STF_ASSERT_TRUE(std::get<2>(expected) == e.option_names);
+        }
+    }
+
+    // The option triggering a dependency need not be given
+    parser.ClearOptions();
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-i", "in", "-o", "out", "-p", "secret"});
+
+    // Taking an option's values means it is no longer given
+    parser.TakeOptionStrings("input");
+    try
+    {
+        parser.ParseArguments(std::vector<std::string>{"program"});
+        STF_ASSERT_TRUE(false);
+    }
+    catch (const Terra::ProgramOptions::ConstraintException &e)
+    {
+        STF_ASSERT_EQ(OptionsError::MissingRequiredOption, e.options_error);
+    }
+
+    // Constraints must name known options, and enough of them
+    const std::vector<Terra::ProgramOptions::Constraints> invalid =
+    {
+        {{ConstraintType::Required, {"unknown"}}},
+        {{ConstraintType::Required, {""}}},
+        {{ConstraintType::Exclusive, {"json"}}},
+        {{ConstraintType::Requires, {"user"}}}
+    };
+    for (const auto &constraints : invalid)
+    {
+        try
+        {
+            parser.SetConstraints(constraints);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::SpecificationException &e)
+        {
+            STF_ASSERT_EQ(OptionsError::InvalidConstraint, e.options_error);
+        }
+    }
+
+    // Setting the options removes the constraints
+    parser.SetOptions(options);
+    STF_ASSERT_EQ(unconstrained, parser.GetSpecFingerprint());
+    parser.ParseArguments(std::vector<std::string>{"program", "-j", "-x"});
+}
+
+STF_TEST(ProgramOptions, TestOptionPresence)
+{
+    Terra::ProgramOptions::Options options =
+    {
+        {"verbose", "v", "verbose", true,  false},
+        {"debug",   "d", "debug",   false, false},
+        {"trace",   "t", "trace",   false, false},
+        {"file",    "f", "file",    true,  true }
+    };
+    for (std::size_t i = 0; i < 70; i++)
+    {
+        options.push_back({"extra" + std::to_string(i),
+                           "",
+                           "extra" + std::to_string(i),
+                           false,
+                           false});
+    }
+
+    Terra::ProgramOptions::Parser parser(options);
+
+    // Handles are the indices of the options
+    const std::size_t verbose = parser.GetOptionHandle("verbose");
+    const std::size_t extra = parser.GetOptionHandle("extra69");
+    STF_ASSERT_EQ(std::size_t(0), verbose);
+    STF_ASSERT_EQ(std::size_t(73), extra);
+
+    const auto debugging = parser.GetOptionMask({"debug", "trace"});
+    const auto required = parser.GetOptionMask({"file", "extra69"});
+    STF_ASSERT_EQ(std::size_t(2), debugging.Words().size());
+
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-vvv", "-f", "a", "--trace", "--extra69", "-f", "b",
+        "positional"});
+
+    Terra::ProgramOptions::OptionPresence presence =
+                                                parser.GetOptionPresence();
+    STF_ASSERT_TRUE(presence.Test(verbose));
+    STF_ASSERT_TRUE(presence.Test(extra));
+    STF_ASSERT_FALSE(presence.Test(parser.GetOptionHandle("debug")));
+    STF_ASSERT_EQ(std::size_t(4), presence.Count());
+    STF_ASSERT_TRUE(presence.Any(debugging));
+    STF_ASSERT_FALSE(presence.All(debugging));
+    STF_ASSERT_TRUE(presence.All(required));
+
+    std::vector<std::size_t> handles;
+    presence.ForEach([&](std::size_t handle) { handles.push_back(handle); });
+    STF_ASSERT_TRUE((std::vector<std::size_t>{0, 2, 3, 73} == handles));
+
+    std::span<const std::size_t> counts = parser.GetOptionCounts();
+    STF_ASSERT_EQ(options.size(), counts.size());
+    STF_ASSERT_EQ(std::size_t(3), counts[verbose]);
+    STF_ASSERT_EQ(std::size_t(2), counts[parser.GetOptionHandle("file")]);
+    STF_ASSERT_EQ(std::size_t(0), counts[parser.GetOptionHandle("debug")]);
+
+    // Clearing empties the set and the counts, leaving the snapshot intact
+    parser.ClearOptions();
+    STF_ASSERT_TRUE(parser.GetOptionPresence().Empty());
+    STF_ASSERT_EQ(std::size_t(0), parser.GetOptionCounts()[verbose]);
+    STF_ASSERT_TRUE(presence.Test(verbose));
+
+    // Taking values removes the option from the set
+    parser.ParseArguments(std::vector<std::string>{"program", "-f", "a", "-d"});
+    parser.TakeOptionStrings("file");
+    STF_ASSERT_TRUE(parser.GetOptionPresence() ==
+                    parser.GetOptionMask({"debug"}));
+    STF_ASSERT_EQ(std::size_t(0),
+                  parser.GetOptionCounts()[parser.GetOptionHandle("file")]);
+
+    // Only options have handles
+    for (const std::string name : {"", "unknown"})
+    {
+        try
+        {
+            parser.GetOptionHandle(name);
+            STF_ASSERT_TRUE(false);
+        }
+        catch (const Terra::ProgramOptions::OptionsException &e)
+        {
+            STF_ASSERT_EQ(Terra::ProgramOptions::OptionsError::UnknownOption,
+                          e.options_error);
+        }
+    }
+}
+
+STF_TEST(ProgramOptions, TestTerminators)
+{
+    using Terra::ProgramOptions::OptionOrder;
+
+    const Terra::ProgramOptions::Options options =
+    {
+        {"verbose", "v", "verbose", true,  false},
+        {"output",  "o", "output",  true,  true }
+    };
+    const char *arguments[] =
+    {
+        "program", "-v", "file1", "-o", "--", "--", "-v", "--output=x",
+        "file2"
+    };
+    const auto argv = std::span(arguments);
+
+    // By default, "--" is stored as an argument and parsing continues
+    Terra::ProgramOptions::Parser parser(options);
+    parser.ParseArguments(static_cast<int>(argv.size()), arguments);
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionCount("verbose"));
+    STF_ASSERT_TRUE((std::vector<std::string>{"--", "x"} ==
+                     parser.GetOptionStrings("output")));
+    STF_ASSERT_TRUE((std::vector<std::string>{"file1", "--", "file2"} ==
+                     parser.GetOptionStrings("")));
+    STF_ASSERT_FALSE(parser.GetRemainderPosition().has_value());
+    STF_ASSERT_TRUE(parser.GetRemainder(argv).empty());
+
+    // A terminator ends parsing; the terminator given as a value does not
+    const std::uint64_t fingerprint = parser.GetSpecFingerprint();
+    parser.SetTerminators({"--"});
+    STF_ASSERT_NE(fingerprint, parser.GetSpecFingerprint());
+    parser.ParseArguments(static_cast<int>(argv.size()), arguments);
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::string("--"), parser.GetOptionString("output"));
+    STF_ASSERT_TRUE((std::vector<std::string>{"file1"} ==
+                     parser.GetOptionStrings("")));
+    STF_ASSERT_EQ(std::size_t(6), parser.GetRemainderPosition().value());
+
+    // The remainder refers to the original arguments
+    std::span<const char *> remainder = parser.GetRemainder(argv);
+    STF_ASSERT_EQ(std::size_t(3), remainder.size());
+    STF_ASSERT_TRUE(remainder.data() == &arguments[6]);
+
+    // A final terminator leaves an empty remainder
+    parser.ClearOptions();
+    STF_ASSERT_FALSE(parser.GetRemainderPosition().has_value());
+    parser.ParseArguments(std::vector<std::string>{"program", "-v", "--"});
+    STF_ASSERT_EQ(std::size_t(3), parser.GetRemainderPosition().value());
+
+    // With options first, parsing stops at the first other argument
+    parser.SetTerminators({});
+    parser.SetOptionOrder(OptionOrder::OptionsFirst);
+    parser.ParseArguments(static_cast<int>(argv.size()), arguments);
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("verbose"));
+    STF_ASSERT_FALSE(parser.OptionGiven("output"));
+    STF_ASSERT_EQ(std::size_t(0), parser.GetOptionCount(""));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetRemainderPosition().value());
+    STF_ASSERT_EQ(std::string_view("file1"), parser.GetRemainder(argv)[0]);
+
+    // The value of an option is not the first other argument, while an
+    // argument of only flag characters is
+    const std::vector<std::string> values = {
+        "program", "-o", "value", "-", "-v"};
+    parser.ClearOptions();
+    parser.ParseArguments(values);
+    STF_ASSERT_EQ(std::string("value"), parser.GetOptionString("output"));
+    STF_ASSERT_FALSE(parser.OptionGiven("verbose"));
+    std::span<const std::string> rest = parser.GetRemainder(std::span(values));
+    STF_ASSERT_EQ(std::size_t(2), rest.size());
+    STF_ASSERT_EQ(std::string("-"), rest.front());
+
+    // Both may be used together, and both apply to the counting pass
+    parser.SetTerminators({"--"});
+    parser.SetParseStrategy(Terra::ProgramOptions::ParseStrategy::TwoPass);
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-v", "--", "file", "-v"});
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::size_t(3), parser.GetRemainderPosition().value());
+
+    // The counting pass does not examine arguments following the first
+    // argument not associated with an option
+    parser.SetTerminators({});
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-v", "child", "--child-option"});
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::size_t(0), parser.GetOptionCount(""));
+    STF_ASSERT_EQ(std::size_t(2), parser.GetRemainderPosition().value());
+}
+
+STF_TEST(ProgramOptions, TestUnknownOptions)
+{
+    using Terra::ProgramOptions::UnknownOptions;
+
+    const Terra::ProgramOptions::Options options =
+    {
+        {"verbose", "v", "verbose", true,  false},
+        {"output",  "o", "output",  false, true }
+    };
+    const char *arguments[] =
+    {
+        "program", "--jobs", "4", "-v", "--color=auto", "-vz", "-o", "x",
+        "file", "-j", "-1", "-x", "-"
+    };
+    const auto argc = static_cast<int>(std::size(arguments));
+    Terra::ProgramOptions::Parser parser(options);
+
+    // By default, unknown options are rejected
+    bool exception_caught = false;
+    try
+    {
+        parser.ParseArguments(argc, arguments);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        exception_caught = e.options_error ==
+            Terra::ProgramOptions::OptionsError::InvalidLongOption;
+    }
+    STF_ASSERT_TRUE(exception_caught);
+
+    // Passed through, the positions of unknown options are recorded in
+    // order and a bundle having an unknown character is not stored
+    const std::uint64_t fingerprint = parser.GetSpecFingerprint();
+    parser.SetUnknownOptions(UnknownOptions::PassThrough);
+    STF_ASSERT_NE(fingerprint, parser.GetSpecFingerprint());
+    parser.ParseArguments(argc, arguments);
+    STF_ASSERT_TRUE((std::vector<std::size_t>{1, 4, 5, 9, 10, 11} ==
+                     std::vector<std::size_t>(
+                         parser.GetUnknownPositions().begin(),
+                         parser.GetUnknownPositions().end())));
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::string("x"), parser.GetOptionString("output"));
+    STF_ASSERT_TRUE((std::vector<std::string>{"4", "file", "-"} ==
+                     parser.GetOptionStrings("")));
+
+    // Values are taken unless given in the argument or appearing to be an
+    // option (as "-1" does), though an argument of only a flag character
+    // is a value
+    parser.SetUnknownOptions(UnknownOptions::PassThroughWithValues);
+    parser.ParseArguments(argc, arguments);
+    STF_ASSERT_TRUE((std::vector<std::size_t>{1, 2, 4, 5, 9, 10, 11, 12} ==
+                     std::vector<std::size_t>(
+                         parser.GetUnknownPositions().begin(),
+                         parser.GetUnknownPositions().end())));
+    STF_ASSERT_TRUE((std::vector<std::string>{"file"} ==
+                     parser.GetOptionStrings("")));
+    STF_ASSERT_EQ(std::string_view("--color=auto"),
+                  arguments[parser.GetUnknownPositions()[2]]);
+
+    // Clearing options clears the positions, and a terminator is never
+    // taken as a value
+    parser.ClearOptions();
+    STF_ASSERT_TRUE(parser.GetUnknownPositions().empty());
+    parser.SetTerminators({"--"});
+    parser.SetUnknownOptions(UnknownOptions::PassThroughWithValues);
+    parser.ParseArguments(
+        std::vector<std::string>{"program", "--jobs", "--", "4"});
+    STF_ASSERT_EQ(std::size_t(1), parser.GetUnknownPositions().size());
+    STF_ASSERT_EQ(std::size_t(3), parser.GetRemainderPosition().value());
+
+    // The counting pass examines the same arguments
+    parser.SetTerminators({});
+    parser.SetParseStrategy(Terra::ProgramOptions::ParseStrategy::TwoPass);
+    parser.ParseArguments(argc, arguments);
+    STF_ASSERT_EQ(std::size_t(8), parser.GetUnknownPositions().size());
+    STF_ASSERT_TRUE((std::vector<std::string>{"file"} ==
+                     parser.GetOptionStrings("")));
+}
+
+STF_TEST(ProgramOptions, TestArgumentVector)
+{
+    Terra::ProgramOptions::ArgumentVector arguments;
+
+    STF_ASSERT_TRUE(arguments.Empty());
+    STF_ASSERT_TRUE(arguments.Data()[0] == nullptr);
+
+    arguments.Append("program");
+    arguments.Append({"--name", "=", "value"});
+    arguments.Append("");
+    arguments.Extend("tail");
+
+    // All arguments are null-terminated and held in one buffer
+    STF_ASSERT_EQ(std::size_t(3), arguments.Size());
+    STF_ASSERT_EQ(std::string_view("--name=value"), arguments[1]);
+    STF_ASSERT_EQ(std::string_view("tail"), arguments[2]);
+
+    char *const *argv = arguments.Data();
+    STF_ASSERT_EQ(std::string_view("program"), argv[0]);
+    STF_ASSERT_EQ(std::string_view("--name=value"), argv[1]);
+    STF_ASSERT_EQ(std::string_view("tail"), argv[2]);
+    STF_ASSERT_TRUE(argv[3] == nullptr);
+    STF_ASSERT_TRUE(argv[1] == argv[0] + 8);
+
+    // A copy refers to its own buffer
+    Terra::ProgramOptions::ArgumentVector copy = arguments;
+    arguments.Clear();
+    STF_ASSERT_TRUE(arguments.Empty());
+    STF_ASSERT_EQ(std::string_view("tail"), copy.Data()[2]);
+    STF_ASSERT_TRUE(copy.Data()[0] != argv[0]);
+
+    // Arguments may be formed from arguments already held, including when
+    // the buffer grows
+    Terra::ProgramOptions::ArgumentVector repeated;
+    std::vector<std::string> expected = {std::string(100, 'x')};
+    repeated.Append(expected[0]);
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        repeated.Append({repeated[i], "-", repeated[0]});
+        repeated.Extend(repeated[i + 1]);
+
+        const std::string argument = expected[i] + "-" + expected[0];
+        expected.push_back(argument + argument);
+    }
+    STF_ASSERT_EQ(expected.size(), repeated.Size());
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        STF_ASSERT_EQ(std::string_view(expected[i]), repeated[i]);
+        STF_ASSERT_EQ(std::string_view(expected[i]), repeated.Data()[i]);
+    }
+}
+
+STF_TEST(ProgramOptions, TestAppendOptions)
+{
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "verbose",   "v",   "verbose",  true,  false },
+        { "output",    "o",   "",         false, true  },
+        { "define",    "D",   "define",   true,  true  },
+        { "ids",       "i",   "ids",      true,  true,  {},
+          ValueType::Integer, {}, {}, ',' },
+        { "ratio",     "r",   "ratio",    false, true,  {},
+          ValueType::Floating },
+        { "color",     "c",   "color",    false, true,  {},
+          ValueType::String, {}, {"red", "green", "blue"} },
+        { "cpus",      "C",   "cpus",     false, true,  {},
+          ValueType::IntervalSet },
+        { "env",       "e",   "env",      true,  true,  {},
+          ValueType::Map }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "-D", "a=1", "-vv", "file", "--ids=01,2", "-o", "x",
+        "-r", "0.50", "--color=blue", "-C", "0-3,4,9", "--define", "b",
+        "-i", "3"});
+
+    // Options are given in canonical form in the order first given, and the
+    // result parses to the same values
+    Terra::ProgramOptions::ArgumentVector child;
+    child.Append("child");
+    parser.AppendOptions(child);
+
+    const std::vector<std::string> expected = {
+        "child", "--define=a=1", "--define=b", "--verbose", "--verbose",
+        "--ids=1,2,3", "-o", "x", "--ratio=0.5", "--color=blue",
+        "--cpus=0-4,9"};
+    STF_ASSERT_EQ(expected.size(), child.Size());
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        STF_ASSERT_EQ(std::string_view(expected[i]), child[i]);
+    }
+
+    Terra::ProgramOptions::Parser reparsed(options);
+    reparsed.ParseArguments(static_cast<int>(child.Size()), child.Data());
+    STF_ASSERT_EQ(std::size_t(2), reparsed.GetOptionCount("verbose"));
+    STF_ASSERT_EQ(std::string("x"), reparsed.GetOptionString("output"));
+    STF_ASSERT_EQ(std::size_t(3), reparsed.GetOptionIntegers("ids").size());
+    STF_ASSERT_TRUE(std::ranges::equal(
+                        parser.GetOptionIntervals("cpus").Intervals(),
+                        reparsed.GetOptionIntervals("cpus").Intervals()));
+
+    // Excluded options may be replaced, and arguments follow a terminator
+    child.Clear();
+    child.Append("child");
+    parser.AppendOptions(child, parser.GetOptionMask({"define", "ids"}));
+    child.Append({"--ids=", "7"});
+    child.Append("--");
+    for (const auto &argument : parser.GetOptionStringsView(""))
+    {
+        child.Append(argument);
+    }
+    STF_ASSERT_EQ(std::size_t(11), child.Size());
+    STF_ASSERT_EQ(std::string_view("--ids=7"), child[8]);
+    STF_ASSERT_EQ(std::string_view("file"), child[10]);
+
+    // Options whose values are not retained must be excluded
+    parser.ParseArguments(std::vector<std::string>{"program", "-e", "k=v"});
+    bool exception_caught = false;
+    try
+    {
+        parser.AppendOptions(child);
+    }
+    catch (const Terra::ProgramOptions::OptionsException &e)
+    {
+        exception_caught = e.options_error ==
+            Terra::ProgramOptions::OptionsError::ValueTypeMismatch;
+    }
+    STF_ASSERT_TRUE(exception_caught);
+    STF_ASSERT_EQ(std::size_t(11), child.Size());
+    parser.AppendOptions(child, parser.GetOptionMask({"env"}));
+}
+
+STF_TEST(ProgramOptions, TestStringGettersRejectTypedValues)
+{
+    using Terra::ProgramOptions::ValueType;
+
+    // clang-format off
+    const Terra::ProgramOptions::Options options =
+    {
+    //    Name       Short    Long        Multi  Argument
+        { "num",       "n",   "num",      false, true,  {},
+          ValueType::Integer },
+        { "color",     "c",   "color",    false, true,  {},
+          ValueType::String, {}, {"red", "green", "blue"} },
+        { "cpus",      "C",   "cpus",     false, true,  {},
+          ValueType::IntervalSet },
+        { "env",       "e",   "env",      false, true,  {},
+          ValueType::Map },
+        { "verbose",   "v",   "verbose",  true,  false }
+    };
+    // clang-format on
+
+    Terra::ProgramOptions::Parser parser(options);
+    parser.ParseArguments(std::vector<std::string>{
+        "program", "--num=42", "--color=red", "--cpus=0-3", "--env=a=b",
+        "-vv"});
+
+    // Each string getter reports that typed options have no strings
+    const std::vector<std::function<void(const std::string &)>> getters =
+    {
+        [&](const std::string &name) { parser.GetOptionString(name); },
+        [&](const std::string &name) { parser.GetOptionStrings(name); },
+        [&](const std::string &name) { parser.GetOptionStringView(name); },
+        [&](const std::string &name) { parser.GetOptionStringsView(name); },
+        [&](const std::string &name) { parser.TakeOptionStrings(name); }
+    };
+
+    for (const std::string name : {"num", "color", "cpus", "env"})
+    {
+        for (const auto &getter : getters)
+        {
+            bool exception_caught = false;
+            try
+            {
+                getter(name);
+            }
+            catch (const Terra::ProgramOptions::OptionsException &e)
+            {
+                exception_caught = e.options_error ==
+                    Terra::ProgramOptions::OptionsError::ValueTypeMismatch;
+            }
+            STF_ASSERT_TRUE(exception_caught);
+        }
+    }
+
+    // Taking strings failed, so the typed values are retained
+    STF_ASSERT_EQ(std::size_t(1), parser.GetOptionCount("num"));
+    STF_ASSERT_TRUE(parser.GetOptionPresence().Test(0));
+    STF_ASSERT_EQ(std::int64_t(42), parser.GetOptionIntegers("num")[0]);
+
+    // Options that do not expect a value are still presented as empty
+    STF_ASSERT_EQ(std::size_t(2), parser.GetOptionStrings("verbose").size());
+    STF_ASSERT_TRUE(parser.GetOptionStringsView("verbose").empty());
+}